@@ -17,12 +17,16 @@
 #ifdef HOUDINI_SUPPORT
 #include <hboost/python/class.hpp>
 #include <hboost/python/def.hpp>
+#include <hboost/python/dict.hpp>
 #include <hboost/python/enum.hpp>
+#include <hboost/python/list.hpp>
 using namespace hboost::python;
 #else
 #include <boost/noncopyable.hpp>
 #include <boost/python/class.hpp>
 #include <boost/python/def.hpp>
+#include <boost/python/dict.hpp>
+#include <boost/python/list.hpp>
 #include <boost/python/reference_existing_object.hpp>
 #include <boost/python/return_value_policy.hpp>
 #include <boost/python/tuple.hpp>
@@ -30,6 +34,81 @@ using namespace hboost::python;
 using namespace boost::python;
 #endif
 
+namespace
+{
+
+dict
+_ConvertBuckets(const std::map<std::string, RenderStudio::Kit::LiveSessionMemoryBucket>& buckets)
+{
+    dict result;
+    for (const auto& [name, bucket] : buckets)
+    {
+        dict item;
+        item["count"] = bucket.count;
+        item["bytes"] = bucket.bytes;
+        result[name] = item;
+    }
+    return result;
+}
+
+dict
+_LiveSessionUpdateWithBudget(double milliseconds)
+{
+    auto budget = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::duration<double, std::milli>(milliseconds));
+    RenderStudio::Kit::LiveSessionUpdateResult update = RenderStudio::Kit::LiveSessionUpdate(budget);
+
+    dict result;
+    result["updated"] = update.updated;
+    result["remaining"] = update.remaining;
+    result["arenaHeapAllocations"] = update.arenaHeapAllocations;
+    result["arenaHeapBytes"] = update.arenaHeapBytes;
+    return result;
+}
+
+bool
+_LiveSessionWaitForUpdate(double milliseconds)
+{
+    auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::duration<double, std::milli>(milliseconds));
+
+    // Other python threads keep running while this one sleeps
+    bool result = false;
+    Py_BEGIN_ALLOW_THREADS
+    result = RenderStudio::Kit::LiveSessionWaitForUpdate(timeout);
+    Py_END_ALLOW_THREADS
+    return result;
+}
+
+// Plain dicts, so stats could be dumped to json right away
+list
+_LiveSessionGetStats()
+{
+    list result;
+    for (const RenderStudio::Kit::LiveSessionLayerStats& stats : RenderStudio::Kit::LiveSessionGetStats())
+    {
+        dict total;
+        total["count"] = stats.total.count;
+        total["bytes"] = stats.total.bytes;
+
+        dict item;
+        item["identifier"] = stats.identifier;
+        item["total"] = total;
+        item["bySpecType"] = _ConvertBuckets(stats.bySpecType);
+        item["byField"] = _ConvertBuckets(stats.byField);
+        item["byValueType"] = _ConvertBuckets(stats.byValueType);
+        item["localDeltas"] = stats.localDeltas;
+        item["remoteUpdates"] = stats.remoteUpdates;
+        item["unacknowledgedFields"] = stats.unacknowledgedFields;
+        item["accumulatedDeltas"] = stats.accumulatedDeltas;
+        item["subtreeEdits"] = stats.subtreeEdits;
+        result.append(item);
+    }
+    return result;
+}
+
+} // namespace
+
 void
 wrapRenderStudioKit()
 {
@@ -41,8 +120,12 @@ wrapRenderStudioKit()
     ;
 
     def("LiveSessionConnect", &LiveSessionConnect, args("info"));
-    def("LiveSessionUpdate", &LiveSessionUpdate);
+    def("LiveSessionUpdate", static_cast<bool (*)()>(&LiveSessionUpdate));
+    def("LiveSessionUpdateBudgeted", &_LiveSessionUpdateWithBudget, args("budgetMs"));
+    def("LiveSessionWaitForUpdate", &_LiveSessionWaitForUpdate, args("timeoutMs"));
     def("LiveSessionDisconnect", &LiveSessionDisconnect);
+    def("LiveSessionGetStats", &_LiveSessionGetStats);
+    def("LiveSessionGetBacklog", &LiveSessionGetBacklog);
 
     def("SharedWorkspaceConnect", &SharedWorkspaceConnect, args("role"));
     def("SharedWorkspaceDisconnect", &SharedWorkspaceDisconnect);
@@ -34,12 +34,44 @@ LiveSessionUpdate()
     return pxr::RenderStudioResolver::ProcessLiveUpdates();
 }
 
+LiveSessionUpdateResult
+LiveSessionUpdate(std::chrono::microseconds budget)
+{
+    LiveSessionUpdateResult result;
+    result.updated = pxr::RenderStudioResolver::ProcessLiveUpdates(budget, &result);
+    return result;
+}
+
+bool
+LiveSessionWaitForUpdate(std::chrono::milliseconds timeout)
+{
+    return pxr::RenderStudioResolver::WaitForLiveUpdate(timeout);
+}
+
+void
+LiveSessionSetUpdateCallback(std::function<void()> callback)
+{
+    pxr::RenderStudioResolver::SetLiveUpdateCallback(std::move(callback));
+}
+
 void
 LiveSessionDisconnect()
 {
     pxr::RenderStudioResolver::StopLiveMode();
 }
 
+std::vector<LiveSessionLayerStats>
+LiveSessionGetStats()
+{
+    return pxr::RenderStudioResolver::GetLiveStats();
+}
+
+std::size_t
+LiveSessionGetBacklog()
+{
+    return pxr::RenderStudioResolver::GetLiveBacklog();
+}
+
 void
 SharedWorkspaceConnect(Role role)
 {
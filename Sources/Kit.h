@@ -13,7 +13,12 @@
 // limitations under the License.
 
 #pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
 #include <string>
+#include <vector>
 
 namespace RenderStudio::Kit
 {
@@ -35,9 +40,71 @@ void LiveSessionConnect(const LiveSessionInfo& info);
 /// @brief Must be called from USD thread. Pushes local updates and pulls remote updates.
 bool LiveSessionUpdate();
 
+struct LiveSessionUpdateResult
+{
+    bool updated = false;
+
+    // Remote updates received, but not applied yet
+    std::size_t remaining = 0;
+
+    // Transient tables which didn't fit into frame arena and went to heap, stays zero once arena is warmed up
+    std::size_t arenaHeapAllocations = 0;
+    std::size_t arenaHeapBytes = 0;
+};
+
+/// @brief Must be called from USD thread. Same as LiveSessionUpdate, but remote updates are applied in sequence
+/// order only until budget is spent, the rest is applied by next calls. Single update is never split,
+/// so call might take longer than budget by duration of one update.
+LiveSessionUpdateResult LiveSessionUpdate(std::chrono::microseconds budget);
+
+/// @brief Could be called from any thread. Blocks until remote events arrive, which LiveSessionUpdate has to process,
+/// or until timeout. Signal is raised without events too, when previous LiveSessionUpdate left work for later: updates
+/// left after budget, or local edits which are sent or journaled once user stops editing.
+/// Returns true if there's work, signal stays raised until next LiveSessionUpdate.
+bool LiveSessionWaitForUpdate(std::chrono::milliseconds timeout);
+
+/// @brief Callback is called once each time signal of LiveSessionWaitForUpdate is raised. It's called from background
+/// threads of live session (network, message decoding or scheduled wake up), never from inside LiveSessionUpdate.
+/// It must not call LiveSessionUpdate itself, only schedule it on USD thread. Empty callback removes previous one.
+void LiveSessionSetUpdateCallback(std::function<void()> callback);
+
 /// @brief Disconnects from remote live server.
 void LiveSessionDisconnect();
 
+struct LiveSessionMemoryBucket
+{
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+};
+
+struct LiveSessionLayerStats
+{
+    std::string identifier;
+
+    // Estimated bytes of spec table, count is number of specs for total and spec types, number of values otherwise
+    LiveSessionMemoryBucket total;
+    std::map<std::string, LiveSessionMemoryBucket> bySpecType;
+    std::map<std::string, LiveSessionMemoryBucket> byField;
+    std::map<std::string, LiveSessionMemoryBucket> byValueType;
+
+    // Pending queue sizes
+    std::size_t localDeltas = 0;
+    std::size_t remoteUpdates = 0;
+    std::size_t unacknowledgedFields = 0;
+    std::size_t accumulatedDeltas = 0;
+
+    // Namespace edits applied to whole subtree at once
+    std::size_t subtreeEdits = 0;
+};
+
+/// @brief Must be called from USD thread. Returns estimated memory usage and pending queue sizes of live layers.
+/// Counters are kept up to date on every edit, so it's cheap enough to be polled.
+std::vector<LiveSessionLayerStats> LiveSessionGetStats();
+
+/// @brief Could be called from any thread. Returns number of remote deltas received but not applied yet.
+/// Deltas merged together while LiveSessionUpdate wasn't called are counted one by one.
+std::size_t LiveSessionGetBacklog();
+
 // ========== File Syncing API ==========
 
 enum class Role
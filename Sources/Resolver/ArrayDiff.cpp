@@ -0,0 +1,232 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ArrayDiff.h"
+
+#pragma warning(push, 0)
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include <pxr/base/arch/hash.h>
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/vt/array.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace
+{
+
+// Diff is sent only if it's at most quarter of the full array
+constexpr std::size_t kMaxChangedFraction = 4;
+
+// Equal blocks are skipped with single memcmp, which compilers and libc vectorize
+constexpr std::size_t kBlockSize = 64;
+
+template <class T>
+std::uint64_t
+_HashArray(const VtArray<T>& array)
+{
+    return ArchHash64(reinterpret_cast<const char*>(array.cdata()), array.size() * sizeof(T));
+}
+
+template <class T>
+std::optional<RenderStudio::API::ArrayDiff>
+_Compute(const VtArray<T>& base, const VtArray<T>& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Arrays are compared bytewise");
+
+    RenderStudio::API::ArrayDiff diff;
+    diff.baseSize = base.size();
+    diff.baseHash = _HashArray(base);
+    diff.size = value.size();
+
+    const T* lhs = base.cdata();
+    const T* rhs = value.cdata();
+    const std::size_t common = std::min(base.size(), value.size());
+    const std::size_t limit = value.size() / kMaxChangedFraction;
+
+    std::size_t changed = 0;
+
+    // Range is open while its start is less than common
+    std::size_t rangeStart = common;
+
+    auto closeRange = [&diff, &rangeStart, &changed, common](std::size_t end)
+    {
+        if (rangeStart < end)
+        {
+            diff.ranges.push_back(rangeStart);
+            diff.ranges.push_back(end - rangeStart);
+            changed += end - rangeStart;
+        }
+        rangeStart = common;
+    };
+
+    for (std::size_t i = 0; i < common;)
+    {
+        std::size_t blockEnd = std::min(i + kBlockSize, common);
+
+        if (std::memcmp(lhs + i, rhs + i, (blockEnd - i) * sizeof(T)) == 0)
+        {
+            closeRange(i);
+            i = blockEnd;
+            continue;
+        }
+
+        for (; i < blockEnd; i++)
+        {
+            bool same = std::memcmp(lhs + i, rhs + i, sizeof(T)) == 0;
+
+            if (!same && rangeStart == common)
+            {
+                rangeStart = i;
+            }
+            else if (same)
+            {
+                closeRange(i);
+            }
+        }
+
+        if (changed > limit)
+        {
+            return std::nullopt;
+        }
+    }
+
+    // Range still open at the end is merged with appended elements, if any
+    closeRange(value.size());
+
+    if (changed > limit)
+    {
+        return std::nullopt;
+    }
+
+    VtArray<T> values;
+    values.reserve(changed);
+
+    for (std::size_t r = 0; r < diff.ranges.size(); r += 2)
+    {
+        for (std::size_t i = diff.ranges[r]; i < diff.ranges[r] + diff.ranges[r + 1]; i++)
+        {
+            values.push_back(rhs[i]);
+        }
+    }
+
+    diff.values = VtValue::Take(values);
+    return diff;
+}
+
+template <class T>
+bool
+_Apply(const VtArray<T>& base, const RenderStudio::API::ArrayDiff& diff, VtValue* result)
+{
+    if (base.size() != diff.baseSize || _HashArray(base) != diff.baseHash || !diff.values.IsHolding<VtArray<T>>()
+        || diff.ranges.size() % 2 != 0)
+    {
+        return false;
+    }
+
+    const VtArray<T>& values = diff.values.UncheckedGet<VtArray<T>>();
+
+    // Validate before detaching base, it's copy of whole array. Size comes from remote, array can grow only by
+    // elements which diff carries, so malformed diff can't make it allocate more than base and values take
+    std::size_t total = 0;
+    std::size_t extent = base.size();
+    for (std::size_t r = 0; r < diff.ranges.size(); r += 2)
+    {
+        const std::size_t start = diff.ranges[r];
+        const std::size_t count = diff.ranges[r + 1];
+
+        if (count > values.size() - total || start > diff.size || count > diff.size - start)
+        {
+            return false;
+        }
+
+        total += count;
+        extent = std::max(extent, start + count);
+    }
+
+    if (total != values.size() || diff.size > extent)
+    {
+        return false;
+    }
+
+    VtArray<T> patched = base;
+    patched.resize(diff.size);
+
+    T* data = patched.data();
+    const T* source = values.cdata();
+
+    for (std::size_t r = 0; r < diff.ranges.size(); r += 2)
+    {
+        std::copy(source, source + diff.ranges[r + 1], data + diff.ranges[r]);
+        source += diff.ranges[r + 1];
+    }
+
+    *result = VtValue::Take(patched);
+    return true;
+}
+
+} // namespace
+
+std::optional<RenderStudio::API::ArrayDiff>
+RenderStudioArrayDiff::Compute(const VtValue& base, const VtValue& value)
+{
+    // Types must be serializable, see Serialization.cpp
+    if (base.IsHolding<VtArray<GfVec3f>>() && value.IsHolding<VtArray<GfVec3f>>())
+    {
+        return _Compute(base.UncheckedGet<VtArray<GfVec3f>>(), value.UncheckedGet<VtArray<GfVec3f>>());
+    }
+    else if (base.IsHolding<VtArray<GfVec2f>>() && value.IsHolding<VtArray<GfVec2f>>())
+    {
+        return _Compute(base.UncheckedGet<VtArray<GfVec2f>>(), value.UncheckedGet<VtArray<GfVec2f>>());
+    }
+    else if (base.IsHolding<VtArray<float>>() && value.IsHolding<VtArray<float>>())
+    {
+        return _Compute(base.UncheckedGet<VtArray<float>>(), value.UncheckedGet<VtArray<float>>());
+    }
+    else if (base.IsHolding<VtArray<int>>() && value.IsHolding<VtArray<int>>())
+    {
+        return _Compute(base.UncheckedGet<VtArray<int>>(), value.UncheckedGet<VtArray<int>>());
+    }
+
+    return std::nullopt;
+}
+
+bool
+RenderStudioArrayDiff::Apply(const VtValue& base, const RenderStudio::API::ArrayDiff& diff, VtValue* result)
+{
+    if (base.IsHolding<VtArray<GfVec3f>>())
+    {
+        return _Apply(base.UncheckedGet<VtArray<GfVec3f>>(), diff, result);
+    }
+    else if (base.IsHolding<VtArray<GfVec2f>>())
+    {
+        return _Apply(base.UncheckedGet<VtArray<GfVec2f>>(), diff, result);
+    }
+    else if (base.IsHolding<VtArray<float>>())
+    {
+        return _Apply(base.UncheckedGet<VtArray<float>>(), diff, result);
+    }
+    else if (base.IsHolding<VtArray<int>>())
+    {
+        return _Apply(base.UncheckedGet<VtArray<int>>(), diff, result);
+    }
+
+    return false;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,41 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <optional>
+
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#pragma warning(pop)
+
+#include <Serialization/Api.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Sparse diff between two versions of the same array field, so edits of few elements in huge arrays
+/// (points of sculpted mesh) travel as changed index ranges instead of whole array.
+/// Only arrays of plain numeric element types are supported.
+class RenderStudioArrayDiff
+{
+public:
+    /// Returns nothing if type isn't supported or so many elements were changed that full value is cheaper
+    static std::optional<RenderStudio::API::ArrayDiff> Compute(const VtValue& base, const VtValue& value);
+
+    /// Returns false if base isn't the array diff was made against
+    static bool Apply(const VtValue& base, const RenderStudio::API::ArrayDiff& diff, VtValue* result);
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
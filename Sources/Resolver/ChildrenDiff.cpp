@@ -0,0 +1,293 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ChildrenDiff.h"
+
+#pragma warning(push, 0)
+#include <algorithm>
+
+#include <pxr/base/tf/hashmap.h>
+#include <pxr/base/tf/hashset.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace
+{
+
+using ChildrenOp = RenderStudio::API::ChildrenOp;
+
+// Ops are sent only if there are at most half as many of them as list elements
+constexpr std::size_t kMaxOpsFraction = 2;
+
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+// Marks longest increasing subsequence of base positions, these elements keep their places and aren't moved
+std::vector<bool>
+_FindKept(const std::vector<std::size_t>& positions)
+{
+    std::vector<std::size_t> tails;
+    std::vector<std::size_t> previous(positions.size(), npos);
+
+    for (std::size_t i = 0; i < positions.size(); i++)
+    {
+        if (positions[i] == npos)
+        {
+            continue;
+        }
+
+        auto it = std::lower_bound(
+            tails.begin(),
+            tails.end(),
+            positions[i],
+            [&positions](std::size_t index, std::size_t position) { return positions[index] < position; });
+
+        previous[i] = it == tails.begin() ? npos : *(it - 1);
+
+        if (it == tails.end())
+        {
+            tails.push_back(i);
+        }
+        else
+        {
+            *it = i;
+        }
+    }
+
+    std::vector<bool> kept(positions.size(), false);
+    for (std::size_t i = tails.empty() ? npos : tails.back(); i != npos; i = previous[i])
+    {
+        kept[i] = true;
+    }
+
+    return kept;
+}
+
+} // namespace
+
+std::optional<std::vector<ChildrenOp>>
+RenderStudioChildrenDiff::Compute(
+    const TfToken& field,
+    const std::vector<TfToken>& base,
+    const std::vector<TfToken>& value)
+{
+    // Ops against empty list are just the whole list
+    if (base.empty())
+    {
+        return std::nullopt;
+    }
+
+    const std::size_t limit = std::max(base.size(), value.size()) / kMaxOpsFraction;
+
+    // Usual edits touch the end or single place of the list, skip common head and tail with pointer compares
+    std::size_t prefix = 0;
+    while (prefix < base.size() && prefix < value.size() && base[prefix] == value[prefix])
+    {
+        prefix++;
+    }
+
+    std::size_t suffix = 0;
+    while (suffix < base.size() - prefix && suffix < value.size() - prefix
+           && base[base.size() - suffix - 1] == value[value.size() - suffix - 1])
+    {
+        suffix++;
+    }
+
+    const std::size_t baseEnd = base.size() - suffix;
+    const std::size_t valueEnd = value.size() - suffix;
+
+    TfHashMap<TfToken, std::size_t, TfToken::HashFunctor> basePositions;
+    for (std::size_t i = prefix; i < baseEnd; i++)
+    {
+        if (!basePositions.insert({ base[i], i }).second)
+        {
+            // Not a valid children list
+            return std::nullopt;
+        }
+    }
+
+    TfHashSet<TfToken, TfToken::HashFunctor> valueNames(value.begin() + prefix, value.begin() + valueEnd);
+    std::vector<ChildrenOp> ops;
+
+    for (std::size_t i = prefix; i < baseEnd; i++)
+    {
+        if (valueNames.count(base[i]) == 0)
+        {
+            ops.push_back(ChildrenOp { field, ChildrenOp::Type::Remove, base[i], TfToken() });
+        }
+    }
+
+    std::vector<std::size_t> positions(valueEnd - prefix, npos);
+    for (std::size_t i = prefix; i < valueEnd; i++)
+    {
+        auto it = basePositions.find(value[i]);
+        positions[i - prefix] = it != basePositions.end() ? it->second : npos;
+    }
+
+    // Elements are placed in final order, so each anchor is already in place when it's referenced
+    std::vector<bool> kept = _FindKept(positions);
+    for (std::size_t i = prefix; i < valueEnd; i++)
+    {
+        if (kept[i - prefix])
+        {
+            continue;
+        }
+
+        TfToken anchor = i > 0 ? value[i - 1] : TfToken();
+        ChildrenOp::Type type = positions[i - prefix] == npos ? ChildrenOp::Type::Insert : ChildrenOp::Type::Move;
+        ops.push_back(ChildrenOp { field, type, value[i], anchor });
+
+        if (ops.size() > limit)
+        {
+            return std::nullopt;
+        }
+    }
+
+    if (ops.size() > limit)
+    {
+        return std::nullopt;
+    }
+
+    return ops;
+}
+
+bool
+RenderStudioChildrenDiff::Apply(
+    std::vector<TfToken>& children,
+    const TfToken& field,
+    const std::vector<ChildrenOp>& ops,
+    const std::function<bool(const TfToken&)>& isPendingLocal)
+{
+    if (std::none_of(ops.begin(), ops.end(), [&field](const ChildrenOp& op) { return op.field == field; }))
+    {
+        return false;
+    }
+
+    // List is turned into circular linked list once, node 0 is sentinel before first and after last element.
+    // Ops then find, unlink and link elements by name without shifting or searching the list
+    struct Node
+    {
+        TfToken name;
+        std::size_t prev = 0;
+        std::size_t next = 0;
+    };
+
+    std::vector<Node> nodes(children.size() + 1);
+    TfHashMap<TfToken, std::size_t, TfToken::HashFunctor> index;
+    index.reserve(children.size());
+
+    for (std::size_t i = 1; i <= children.size(); i++)
+    {
+        nodes[i] = Node { children[i - 1], i - 1, i == children.size() ? 0 : i + 1 };
+        index.insert({ children[i - 1], i });
+    }
+
+    nodes[0].next = children.empty() ? 0 : 1;
+    nodes[0].prev = children.size();
+
+    auto unlink = [&nodes, &index](std::size_t node)
+    {
+        nodes[nodes[node].prev].next = nodes[node].next;
+        nodes[nodes[node].next].prev = nodes[node].prev;
+        index.erase(nodes[node].name);
+    };
+
+    auto linkAfter = [&nodes, &index](std::size_t node, std::size_t after)
+    {
+        nodes[node].prev = after;
+        nodes[node].next = nodes[after].next;
+        nodes[nodes[after].next].prev = node;
+        nodes[after].next = node;
+        index.insert({ nodes[node].name, node });
+    };
+
+    bool changed = false;
+
+    for (const ChildrenOp& op : ops)
+    {
+        if (op.field != field)
+        {
+            continue;
+        }
+
+        auto existing = index.find(op.name);
+        std::size_t node = 0;
+
+        switch (op.type)
+        {
+        case ChildrenOp::Type::Remove:
+            if (existing != index.end())
+            {
+                unlink(existing->second);
+                changed = true;
+            }
+            continue;
+
+        case ChildrenOp::Type::Insert:
+            if (existing != index.end())
+            {
+                continue;
+            }
+
+            node = nodes.size();
+            nodes.push_back(Node { op.name });
+            break;
+
+        case ChildrenOp::Type::Move:
+            // Element removed concurrently stays removed
+            if (existing == index.end())
+            {
+                continue;
+            }
+
+            node = existing->second;
+            unlink(node);
+            break;
+        }
+
+        // If anchor was removed concurrently, element goes to the end
+        std::size_t after = nodes[0].prev;
+        if (op.anchor.IsEmpty())
+        {
+            after = 0;
+        }
+        else if (auto anchor = index.find(op.anchor); anchor != index.end())
+        {
+            after = anchor->second;
+        }
+
+        while (nodes[after].next != 0 && isPendingLocal(nodes[nodes[after].next].name))
+        {
+            after = nodes[after].next;
+        }
+
+        linkAfter(node, after);
+        changed = true;
+    }
+
+    if (!changed)
+    {
+        return false;
+    }
+
+    children.clear();
+    for (std::size_t node = nodes[0].next; node != 0; node = nodes[node].next)
+    {
+        children.push_back(nodes[node].name);
+    }
+
+    return true;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
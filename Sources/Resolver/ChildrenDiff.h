@@ -0,0 +1,54 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+#pragma warning(pop)
+
+#include <Serialization/Api.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Ordered list edits for children lists (primChildren, propertyChildren), so adding single prim under scope
+/// with thousands of children sends and merges one insert instead of the whole list.
+/// Children names are unique within the list, so names themselves identify list elements.
+class RenderStudioChildrenDiff
+{
+public:
+    /// Returns nothing if lists differ so much that full list is cheaper
+    static std::optional<std::vector<RenderStudio::API::ChildrenOp>> Compute(
+        const TfToken& field,
+        const std::vector<TfToken>& base,
+        const std::vector<TfToken>& value);
+
+    /// Applies ops of given field in order, ops of other fields are skipped. All ops are idempotent.
+    /// Concurrent inserts after the same anchor end up in the same order everywhere: element sequenced later
+    /// by server goes closer to anchor. So remote insert is placed after elements inserted locally which aren't
+    /// sequenced yet, isPendingLocal tells which ones are. List is indexed once for all the ops, so cost is
+    /// list length plus number of ops rather than their product. Returns false if ops didn't change anything.
+    static bool Apply(
+        std::vector<TfToken>& children,
+        const TfToken& field,
+        const std::vector<RenderStudio::API::ChildrenOp>& ops,
+        const std::function<bool(const TfToken&)>& isPendingLocal);
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -15,9 +15,14 @@
 #include "Data.h"
 
 #pragma warning(push, 0)
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <optional>
 #include <set>
 
+#include <pxr/base/tf/envSetting.h>
 #include <pxr/base/trace/trace.h>
 #include <pxr/base/work/utils.h>
 #include <pxr/pxr.h>
@@ -27,15 +32,100 @@
 #include <pxr/usd/usd/notice.h>
 #pragma warning(pop)
 
+#include "ArrayDiff.h"
+#include "ChildrenDiff.h"
+#include "FieldPatch.h"
 #include "Logger/Logger.h"
+#include "Registry.h"
 #include "Resolver.h"
 #include "Serialization/Serialization.h"
+#include "ValuePool.h"
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+TF_DEFINE_ENV_SETTING(
+    RENDER_STUDIO_HIERARCHY_INDEX,
+    true,
+    "Keep parent to children index in RenderStudioData, so subtree erase and move cost O(subtree)");
+
+TF_DEFINE_ENV_SETTING(
+    RENDER_STUDIO_DATA_SNAPSHOTS,
+    false,
+    "Publish immutable snapshots of RenderStudioData after each live update, so other threads could read them");
+
+namespace
+{
+
+class _SpecPathVisitor : public SdfAbstractDataSpecVisitor
+{
+public:
+    explicit _SpecPathVisitor(std::function<bool(const SdfPath&)> fn)
+        : mFn(std::move(fn))
+    {
+    }
+
+    virtual bool VisitSpec(const SdfAbstractData&, const SdfPath& path) override { return mFn(path); }
+    virtual void Done(const SdfAbstractData&) override { }
+
+private:
+    std::function<bool(const SdfPath&)> mFn;
+};
+
+// Key of customData which holds name of user that locked primitive
+const std::string kOwnerKey = "owner";
+
+bool
+_IsChildrenField(const TfToken& field)
+{
+    return field == SdfChildrenKeys->PrimChildren || field == SdfChildrenKeys->PropertyChildren;
+}
+
+// Transform values, while user drags they're relayed as ephemeral and only final value goes to history
+bool
+_IsInteractiveDelta(const SdfPath& path, const RenderStudio::API::SpecData& spec)
+{
+    if (!path.IsPropertyPath() || path.GetNameToken().GetString().find("xformOp:") == std::string::npos)
+    {
+        return false;
+    }
+
+    // Attribute creation and other edits are sent right away
+    bool onlyValues = std::all_of(
+        spec.fields.begin(),
+        spec.fields.end(),
+        [](const std::pair<TfToken, VtValue>& field) { return field.first == SdfFieldKeys->Default; });
+
+    return onlyValues && !spec.IsAcknowledge() && spec.arrayDiffs.empty() && spec.childrenOps.empty()
+        && spec.dictionaryOps.empty() && spec.listOpEdits.empty();
+}
+
+// Fields which are sent as diffs or ops against their previous value
+bool
+_IsPatchable(const TfToken& field, const VtValue& value)
+{
+    return value.IsArrayValued() || _IsChildrenField(field) || RenderStudioFieldPatch::IsSupported(value);
+}
+
+void
+_SendOwnerChanged(const SdfPath& path, const VtValue& owner)
+{
+    // Lock is released by setting owner to "None"
+    if (!owner.IsHolding<std::string>() || owner.UncheckedGet<std::string>() == "None")
+    {
+        RenderStudioNotice::OwnerChanged(path, std::nullopt).Send();
+    }
+    else
+    {
+        RenderStudioNotice::OwnerChanged(path, owner.UncheckedGet<std::string>()).Send();
+    }
+}
+
+} // namespace
+
 RenderStudioData::RenderStudioData()
+    : mHierarchyIndexEnabled(TfGetEnvSetting(RENDER_STUDIO_HIERARCHY_INDEX))
+    , mSnapshotsEnabled(TfGetEnvSetting(RENDER_STUDIO_DATA_SNAPSHOTS))
 {
-    // Do nothing
 }
 
 RenderStudioData::~RenderStudioData()
@@ -47,7 +137,7 @@ RenderStudioData::~RenderStudioData()
 void
 RenderStudioData::ApplyDelta(
     SdfLayerHandle& layer,
-    std::vector<RenderStudioNotice::PrimitiveChanged>& notices,
+    _NoticeList& notices,
     const SdfPath& path,
     const TfToken& key,
     const VtValue& value,
@@ -67,27 +157,15 @@ RenderStudioData::ApplyDelta(
     if (key == SdfFieldKeys->CustomData && value.IsHolding<VtDictionary>())
     {
         VtDictionary data = value.Get<VtDictionary>();
-        auto it = data.find("owner");
-        if (it != data.end() && it->first == "owner")
+        auto it = data.find(kOwnerKey);
+        if (it != data.end())
         {
-            std::optional<std::string> owner = [&it]() -> std::optional<std::string>
-            {
-                if (it->second.Get<std::string>() == "None")
-                {
-                    return std::nullopt;
-                }
-                else
-                {
-                    return it->second.Get<std::string>();
-                }
-            }();
-
-            RenderStudioNotice::OwnerChanged(path, owner).Send();
+            _SendOwnerChanged(path, it->second);
         }
     }
 
     bool unacknowledgedYet = mUnacknowledgedFields.count(path) > 0;
-    bool requireMerge = key == SdfChildrenKeys->PrimChildren && unacknowledgedYet;
+    bool requireMerge = _IsChildrenField(key) && unacknowledgedYet;
     bool requireForceApply = path.GetNameToken().GetString().find("xformOp:") != std::string::npos;
 
     // Ignore all unacknowledged updates except mergeable or which must be force applied
@@ -98,6 +176,12 @@ RenderStudioData::ApplyDelta(
 
     if (!requireForceApply && !requireMerge && unacknowledgedYet)
     {
+        // Our diff might have been made against other base than theirs, so send value in full next time
+        if (_IsPatchable(key, value))
+        {
+            _RequestFullResend(path, key);
+        }
+
         LOG_DEBUG << "Skip unacknowledged message: " << path;
         return;
     }
@@ -148,7 +232,7 @@ RenderStudioData::ApplyDelta(
         notices.push_back(RenderStudioNotice::PrimitiveChanged(path, true));
     }
 
-    // Currently we don't sync spec removal, so detect it from empty typeName
+    // Clients without namespace edits still request spec removal with empty typeName
     if (key == SdfFieldKeys->TypeName && value.IsHolding<TfToken>())
     {
         TfToken data = value.Get<TfToken>();
@@ -163,176 +247,1551 @@ RenderStudioData::ApplyDelta(
 }
 
 void
-RenderStudioData::ProcessRemoteUpdates(SdfLayerHandle& layer)
+RenderStudioData::ApplyTimeSampleDelta(
+    SdfLayerHandle& layer,
+    const SdfPath& path,
+    const RenderStudio::API::TimeSampleOp& op,
+    SdfSpecType spec)
 {
-    // Synchronize updates
-    std::unique_lock<std::mutex> lock(mRemoteMutex);
-    mIsProcessingRemoteUpdates = true;
-
-    // Change block should gain performance
-    std::unique_ptr<SdfChangeBlock> block = std::make_unique<SdfChangeBlock>();
-    std::vector<RenderStudioNotice::PrimitiveChanged> notices;
+    if (layer->GetSpecType(path) == SdfSpecTypeUnknown)
+    {
+        layer->GetStateDelegate()->CreateSpec(path, spec, false);
+    }
 
-    // Apply all the deltas (in sequence order)
-    std::size_t nextRequestedSequence = mLatestAppliedSequence + 1;
+    // Same rules as for fields: own unacknowledged edits win, except transformations
+    bool unacknowledgedYet = mUnacknowledgedFields.count(path) > 0;
+    bool requireForceApply = path.GetNameToken().GetString().find("xformOp:") != std::string::npos;
 
-    while (mRemoteDeltasQueue.find(nextRequestedSequence) != mRemoteDeltasQueue.end())
+    if (unacknowledgedYet && !requireForceApply)
     {
-        _HashTable& deltas = mRemoteDeltasQueue.at(nextRequestedSequence);
+        LOG_DEBUG << "Skip unacknowledged time sample: " << path;
+        return;
+    }
 
-        for (const std::pair<SdfPath, _SpecData>& delta : deltas)
-        {
-            // Check if it's acknowledge message (for now it just doesn't contain fields)
-            if (delta.second.fields.empty())
-            {
-                mUnacknowledgedFields.erase(delta.first);
-                continue;
-            }
+    // Empty value erases sample
+    layer->GetStateDelegate()->SetTimeSample(path, op.time, op.value);
+}
 
-            // Process updates
-            for (const std::pair<TfToken, VtValue>& field : delta.second.fields)
-            {
-                ApplyDelta(layer, notices, delta.first, field.first, field.second, delta.second.specType);
-            }
+void
+RenderStudioData::ApplyArrayDiff(
+    SdfLayerHandle& layer,
+    const SdfPath& path,
+    const TfToken& key,
+    const RenderStudio::API::ArrayDiff& diff)
+{
+    // Diff makes no sense without base, so spec must exist already
+    if (mUnacknowledgedFields.count(path) > 0)
+    {
+        _RequestFullResend(path, key);
+        LOG_DEBUG << "Skip unacknowledged array diff: " << path;
+        return;
+    }
 
-            notices.push_back(RenderStudioNotice::PrimitiveChanged(delta.first, false));
-        }
+    VtValue patched;
+    if (!RenderStudioArrayDiff::Apply(layer->GetField(path, key), diff, &patched))
+    {
+        LOG_WARNING << "Array diff doesn't match local value, skipped: " << path << "." << key.GetString();
+        return;
+    }
 
-        mLatestAppliedSequence = nextRequestedSequence;
-        mRemoteDeltasQueue.erase(nextRequestedSequence);
-        nextRequestedSequence += 1;
+    layer->GetStateDelegate()->SetField(path, key, patched);
+}
+
+void
+RenderStudioData::ApplyChildrenOps(
+    SdfLayerHandle& layer,
+    const SdfPath& path,
+    const TfToken& field,
+    const std::vector<RenderStudio::API::ChildrenOp>& ops,
+    SdfSpecType spec)
+{
+    if (layer->GetSpecType(path) == SdfSpecTypeUnknown)
+    {
+        layer->GetStateDelegate()->CreateSpec(path, spec, false);
     }
 
-    block.reset();
+    static const std::vector<TfToken> kEmpty;
+    VtValue current = layer->GetField(path, field);
+    const std::vector<TfToken>& children
+        = current.IsHolding<std::vector<TfToken>>() ? current.UncheckedGet<std::vector<TfToken>>() : kEmpty;
 
-    // Deduplicate notices
-    std::map<SdfPath, std::vector<RenderStudioNotice::PrimitiveChanged>> noticesMap;
-    for (const RenderStudioNotice::PrimitiveChanged& notice : notices)
+    // Appending single child is the usual case, push it without copying the whole list
+    auto isField = [&field](const RenderStudio::API::ChildrenOp& op) { return op.field == field; };
+    if (std::count_if(ops.begin(), ops.end(), isField) == 1)
     {
-        if (notice.IsValid())
+        const RenderStudio::API::ChildrenOp& op = *std::find_if(ops.begin(), ops.end(), isField);
+        if (op.type == RenderStudio::API::ChildrenOp::Type::Insert && !children.empty()
+            && children.back() == op.anchor && std::find(children.begin(), children.end(), op.name) == children.end())
         {
-            noticesMap[notice.GetChangedPrim()].push_back(notice);
+            // Drop own reference, so layer could modify stored list in place
+            current = VtValue();
+            layer->GetStateDelegate()->PushChild(path, field, op.name);
+            return;
         }
     }
 
-    for (const auto& [path, noticeVector] : noticesMap)
-    {
-        auto it = std::find_if(
-            noticeVector.begin(), noticeVector.end(), [](const auto& item) { return item.WasResynched(); });
+    // Own inserts which aren't sequenced by server yet: already sent ones and ones made since last send
+    const auto key = std::make_pair(path, field);
+    const auto pending = mPendingLocalChildren.find(key);
+    const auto base = mLocalDeltaBases.find(key);
 
-        if (it != noticeVector.end())
+    // Names of base list are indexed on first lookup only, most merges never ask
+    std::optional<TfHashSet<TfToken, TfToken::HashFunctor>> baseNames;
+
+    auto isPendingLocal = [&](const TfToken& name)
+    {
+        if (pending != mPendingLocalChildren.end() && pending->second.count(name) > 0)
         {
-            it->Send();
+            return true;
         }
-        else
+
+        if (base != mLocalDeltaBases.end() && base->second.IsHolding<std::vector<TfToken>>())
         {
-            noticeVector.front().Send();
+            if (!baseNames.has_value())
+            {
+                const std::vector<TfToken>& baseChildren = base->second.UncheckedGet<std::vector<TfToken>>();
+                baseNames.emplace(baseChildren.begin(), baseChildren.end());
+            }
+
+            return baseNames->count(name) == 0;
         }
-    }
 
-    mIsProcessingRemoteUpdates = false;
+        return false;
+    };
+
+    std::vector<TfToken> merged = children;
+    if (RenderStudioChildrenDiff::Apply(merged, field, ops, isPendingLocal))
+    {
+        layer->GetStateDelegate()->SetField(path, field, VtValue { std::move(merged) });
+    }
 }
 
 void
-RenderStudioData::AccumulateRemoteUpdate(const _HashTable& deltas, std::size_t sequence)
+RenderStudioData::ApplyDictionaryOp(
+    SdfLayerHandle& layer,
+    const SdfPath& path,
+    const RenderStudio::API::DictionaryOp& op,
+    SdfSpecType spec)
 {
-    std::unique_lock<std::mutex> lock(mRemoteMutex);
-    mRemoteDeltasQueue[sequence] = deltas;
-}
+    if (layer->GetSpecType(path) == SdfSpecTypeUnknown)
+    {
+        layer->GetStateDelegate()->CreateSpec(path, spec, false);
+    }
 
-RenderStudioData::_HashTable
-RenderStudioData::FetchLocalDeltas()
-{
-    auto copy = mLocalDeltas;
-    mLocalDeltas.clear();
-    return copy;
-}
+    // Keys are merged one by one, only own unacknowledged edit of the same key wins
+    const auto key = std::make_pair(path, op.field);
+    const auto pending = mPendingLocalKeys.find(key);
+    if (pending != mPendingLocalKeys.end() && pending->second.count(op.key) > 0)
+    {
+        LOG_DEBUG << "Skip unacknowledged dictionary key: " << path << "." << op.key;
+        return;
+    }
 
-void
-RenderStudioData::OnLoaded()
-{
-    mIsLoaded = true;
-    mLocalDeltas.clear();
-    mUnacknowledgedFields.clear();
-    mLatestAppliedSequence = 0;
-    mRemoteDeltasQueue.clear();
-}
+    // Edits made since last send aren't diffed yet, compare key with delta base
+    const auto base = mLocalDeltaBases.find(key);
+    if (base != mLocalDeltaBases.end() && base->second.IsHolding<VtDictionary>())
+    {
+        const VtDictionary& baseDictionary = base->second.UncheckedGet<VtDictionary>();
+        const VtDictionary current = Get(path, op.field).GetWithDefault<VtDictionary>();
+        auto baseItem = baseDictionary.find(op.key);
+        auto currentItem = current.find(op.key);
 
-bool
-RenderStudioData::StreamsData() const
-{
-    return false;
-}
+        bool changed = (baseItem == baseDictionary.end()) != (currentItem == current.end())
+            || (baseItem != baseDictionary.end() && baseItem->second != currentItem->second);
 
-bool
-RenderStudioData::HasSpec(const SdfPath& path) const
-{
-    return mData.find(path) != mData.end();
+        if (changed)
+        {
+            LOG_DEBUG << "Skip unsent dictionary key: " << path << "." << op.key;
+            return;
+        }
+
+        // Otherwise key would be diffed as own edit and sent back
+        base->second = RenderStudioFieldPatch::ApplyDictionary(base->second, op);
+    }
+
+    if (op.field == SdfFieldKeys->CustomData && op.key == kOwnerKey)
+    {
+        _SendOwnerChanged(path, op.value);
+    }
+
+    layer->GetStateDelegate()->SetField(
+        path, op.field, RenderStudioFieldPatch::ApplyDictionary(layer->GetField(path, op.field), op));
 }
 
 void
-RenderStudioData::EraseSpec(const SdfPath& path)
+RenderStudioData::ApplyListOpEdit(
+    SdfLayerHandle& layer,
+    const SdfPath& path,
+    const RenderStudio::API::ListOpEdit& edit,
+    SdfSpecType spec)
 {
-    _HashTable::iterator i = mData.find(path);
-    if (!TF_VERIFY(i != mData.end(), "No spec to erase at <%s>", path.GetText()))
+    if (layer->GetSpecType(path) == SdfSpecTypeUnknown)
+    {
+        layer->GetStateDelegate()->CreateSpec(path, spec, false);
+    }
+
+    // Same rule as for whole fields, own edit would be sequenced later and overwrite this one
+    if (mUnacknowledgedFields.count(path) > 0)
     {
+        _RequestFullResend(path, edit.field);
+        LOG_DEBUG << "Skip unacknowledged list op edit: " << path;
         return;
     }
-    mData.erase(i);
+
+    VtValue patched;
+    if (!RenderStudioFieldPatch::ApplyListOp(layer->GetField(path, edit.field), edit, &patched))
+    {
+        LOG_WARNING << "List op edit doesn't match local value, skipped: " << path << "." << edit.field.GetString();
+        return;
+    }
+
+    layer->GetStateDelegate()->SetField(path, edit.field, patched);
 }
 
 void
-RenderStudioData::MoveSpec(const SdfPath& oldPath, const SdfPath& newPath)
+RenderStudioData::ApplyNamespaceEdit(
+    SdfLayerHandle& layer,
+    _NoticeList& notices,
+    const RenderStudio::API::NamespaceEdit& edit)
 {
-    _HashTable::iterator old = mData.find(oldPath);
-    if (!TF_VERIFY(old != mData.end(), "No spec to move at <%s>", oldPath.GetString().c_str()))
+    if (!layer->HasSpec(edit.path))
     {
+        LOG_DEBUG << "Skip namespace edit of missing spec: " << edit.path;
         return;
     }
-    bool inserted = mData.insert(std::make_pair(newPath, old->second)).second;
-    if (!TF_VERIFY(inserted))
+
+    // Layer sends change notices for the whole subtree, but walks it spec by spec. While edit is set,
+    // first EraseSpec or MoveSpec call applies it to the whole subtree and the rest are no-ops
+    if (edit.type == RenderStudio::API::NamespaceEdit::Type::Erase)
     {
+        mRemoteNamespaceEdit = &edit;
+        layer->GetStateDelegate()->DeleteSpec(edit.path, false);
+        mRemoteNamespaceEdit = nullptr;
+
+        notices.push_back(RenderStudioNotice::PrimitiveChanged(edit.path, true));
         return;
     }
-    mData.erase(old);
-}
 
-SdfSpecType
-RenderStudioData::GetSpecType(const SdfPath& path) const
-{
-    _HashTable::const_iterator i = mData.find(path);
-    if (i == mData.end())
+    if (layer->HasSpec(edit.newPath))
     {
-        return SdfSpecTypeUnknown;
+        LOG_WARNING << "Can't move " << edit.path << " to existing spec " << edit.newPath;
+        return;
     }
-    return i->second.specType;
+
+    mRemoteNamespaceEdit = &edit;
+    layer->GetStateDelegate()->MoveSpec(edit.path, edit.newPath);
+    mRemoteNamespaceEdit = nullptr;
+
+    notices.push_back(RenderStudioNotice::PrimitiveChanged(edit.path, true));
+    notices.push_back(RenderStudioNotice::PrimitiveChanged(edit.newPath, true));
 }
 
-void
-RenderStudioData::CreateSpec(const SdfPath& path, SdfSpecType specType)
+bool
+RenderStudioData::ProcessRemoteUpdates(
+    SdfLayerHandle& layer,
+    std::pmr::memory_resource* arena,
+    std::chrono::steady_clock::time_point deadline)
 {
-    if (!TF_VERIFY(specType != SdfSpecTypeUnknown))
+    // Synchronize updates
+    std::unique_lock<std::mutex> lock(mRemoteMutex);
+    mIsProcessingRemoteUpdates = true;
+
+    // Change block should gain performance
+    std::optional<SdfChangeBlock> block;
+    block.emplace();
+    _NoticeList notices(arena);
+
+    // Interactive values of other users go first, sequenced updates are newer than them
+    for (const auto& [path, spec] : mRemoteEphemeral)
     {
-        return;
+        // Attribute is created by regular delta, value would come again with next ephemeral or final delta
+        if (layer->GetSpecType(path) == SdfSpecTypeUnknown || _IsUnderUnacknowledgedNamespaceEdit(path))
+        {
+            continue;
+        }
+
+        for (const std::pair<TfToken, VtValue>& field : spec.fields)
+        {
+            ApplyDelta(layer, notices, path, field.first, field.second, spec.specType);
+        }
+
+        for (const RenderStudio::API::TimeSampleOp& op : spec.timeSamples)
+        {
+            ApplyTimeSampleDelta(layer, path, op, spec.specType);
+        }
+
+        notices.push_back(RenderStudioNotice::PrimitiveChanged(path, false));
     }
-    mData[path].specType = specType;
-}
+    mRemoteEphemeral.clear();
 
-void
-RenderStudioData::_VisitSpecs(SdfAbstractDataSpecVisitor* visitor) const
-{
-    TF_FOR_ALL(it, mData)
+    // Long histories write same fields over and over, only newest write of each field reaches the layer
+    _FieldWrites newestWrites = CollectNewestWrites(arena);
+
+    // Apply all the deltas (in sequence order). Once deadline passes the rest waits for next live update,
+    // single update is never split
+    std::size_t nextRequestedSequence = mLatestAppliedSequence + 1;
+    bool interrupted = false;
+
+    while (mRemoteDeltasQueue.find(nextRequestedSequence) != mRemoteDeltasQueue.end())
     {
-        if (!visitor->VisitSpec(*this, it->first))
+        if (std::chrono::steady_clock::now() >= deadline)
         {
+            interrupted = true;
             break;
         }
+
+        _RemoteUpdate& update = mRemoteDeltasQueue.at(nextRequestedSequence);
+
+        for (const RenderStudio::API::NamespaceEdit& edit : update.namespaceEdits)
+        {
+            ApplyNamespaceEdit(layer, notices, edit);
+        }
+
+        for (const auto& delta : update.deltas)
+        {
+            // Check if it's acknowledge message (for now it just doesn't contain fields)
+            if (delta.second.IsAcknowledge())
+            {
+                mUnacknowledgedFields.erase(delta.first);
+                mPendingLocalChildren.erase({ delta.first, SdfChildrenKeys->PrimChildren });
+                mPendingLocalChildren.erase({ delta.first, SdfChildrenKeys->PropertyChildren });
+
+                auto pendingKeys = mPendingLocalKeys.lower_bound({ delta.first, TfToken() });
+                while (pendingKeys != mPendingLocalKeys.end() && pendingKeys->first.first == delta.first)
+                {
+                    pendingKeys = mPendingLocalKeys.erase(pendingKeys);
+                }
+
+                mUnacknowledgedNamespaceEdits.erase(delta.first);
+                continue;
+            }
+
+            // Spec is already erased or moved away here, others would erase or move it after this update
+            if (_IsUnderUnacknowledgedNamespaceEdit(delta.first))
+            {
+                LOG_DEBUG << "Skip update under unacknowledged namespace edit: " << delta.first;
+                continue;
+            }
+
+            // Process updates, skipping fields which are overwritten later in the queue
+            const SdfPath& path = delta.first;
+            auto superseded = [&newestWrites, &path, nextRequestedSequence](const TfToken& field)
+            { return IsSuperseded(newestWrites, path, field, nextRequestedSequence); };
+            bool applied = false;
+
+            for (const std::pair<TfToken, VtValue>& field : delta.second.fields)
+            {
+                // Spec erase request isn't overwritten by later fields, they're set on a new spec
+                bool erasesSpec = field.first == SdfFieldKeys->TypeName && field.second.IsHolding<TfToken>()
+                    && field.second.UncheckedGet<TfToken>().IsEmpty();
+
+                if (erasesSpec || !superseded(field.first))
+                {
+                    ApplyDelta(layer, notices, path, field.first, field.second, delta.second.specType);
+                    applied = true;
+                }
+            }
+
+            if (!superseded(SdfDataTokens->TimeSamples))
+            {
+                for (const RenderStudio::API::TimeSampleOp& op : delta.second.timeSamples)
+                {
+                    ApplyTimeSampleDelta(layer, path, op, delta.second.specType);
+                    applied = true;
+                }
+            }
+
+            for (const auto& [key, diff] : delta.second.arrayDiffs)
+            {
+                if (!superseded(key))
+                {
+                    ApplyArrayDiff(layer, path, key, diff);
+                    applied = true;
+                }
+            }
+
+            // All ops of a children list are merged into single copy of it
+            std::vector<TfToken> childrenFields;
+            for (const RenderStudio::API::ChildrenOp& op : delta.second.childrenOps)
+            {
+                if (std::find(childrenFields.begin(), childrenFields.end(), op.field) == childrenFields.end())
+                {
+                    childrenFields.push_back(op.field);
+                }
+            }
+
+            for (const TfToken& field : childrenFields)
+            {
+                if (!superseded(field))
+                {
+                    ApplyChildrenOps(layer, path, field, delta.second.childrenOps, delta.second.specType);
+                    applied = true;
+                }
+            }
+
+            for (const RenderStudio::API::DictionaryOp& op : delta.second.dictionaryOps)
+            {
+                if (!superseded(op.field))
+                {
+                    ApplyDictionaryOp(layer, path, op, delta.second.specType);
+                    applied = true;
+                }
+            }
+
+            for (const RenderStudio::API::ListOpEdit& edit : delta.second.listOpEdits)
+            {
+                if (!superseded(edit.field))
+                {
+                    ApplyListOpEdit(layer, path, edit, delta.second.specType);
+                    applied = true;
+                }
+            }
+
+            if (applied)
+            {
+                notices.push_back(RenderStudioNotice::PrimitiveChanged(path, false));
+            }
+        }
+
+        // Collapsed update covers several sequences
+        mLatestAppliedSequence = update.lastSequence;
+        mRemoteDeltasQueue.erase(nextRequestedSequence);
+        nextRequestedSequence = mLatestAppliedSequence + 1;
+    }
+
+    // Duplicates of sequences covered by collapsed update, they would never be requested
+    mRemoteDeltasQueue.erase(mRemoteDeltasQueue.begin(), mRemoteDeltasQueue.upper_bound(mLatestAppliedSequence));
+
+    block.reset();
+    SendNotices(notices, arena);
+
+    mIsProcessingRemoteUpdates = false;
+
+    // Whole batch was applied, now it's consistent to show it to readers
+    _PublishSnapshot();
+
+    return interrupted;
+}
+
+void
+RenderStudioData::SendNotices(const _NoticeList& notices, std::pmr::memory_resource* arena)
+{
+    // Deduplicate notices
+    std::pmr::map<SdfPath, _NoticeList> noticesMap(arena);
+    for (const RenderStudioNotice::PrimitiveChanged& notice : notices)
+    {
+        if (notice.IsValid())
+        {
+            noticesMap[notice.GetChangedPrim()].push_back(notice);
+        }
+    }
+
+    for (const auto& [path, noticeVector] : noticesMap)
+    {
+        auto it = std::find_if(
+            noticeVector.begin(), noticeVector.end(), [](const auto& item) { return item.WasResynched(); });
+
+        if (it != noticeVector.end())
+        {
+            it->Send();
+        }
+        else
+        {
+            noticeVector.front().Send();
+        }
+    }
+}
+
+RenderStudioData::_FieldWrites
+RenderStudioData::CollectNewestWrites(std::pmr::memory_resource* arena) const
+{
+    _FieldWrites result(arena);
+    std::size_t barrier = 0;
+
+    // Only updates which are applied right now, later ones might still have gaps in sequence
+    for (std::size_t sequence = mLatestAppliedSequence + 1;;)
+    {
+        auto update = mRemoteDeltasQueue.find(sequence);
+        if (update == mRemoteDeltasQueue.end())
+        {
+            break;
+        }
+
+        // Namespace edits are applied before deltas of the same update
+        if (!update->second.namespaceEdits.empty())
+        {
+            barrier = sequence;
+        }
+
+        for (const auto& [path, spec] : update->second.deltas)
+        {
+            for (const auto& [field, value] : spec.fields)
+            {
+                result[{ path, field }] = _FieldWrite { sequence, barrier };
+            }
+        }
+
+        sequence = update->second.lastSequence + 1;
+    }
+
+    return result;
+}
+
+bool
+RenderStudioData::IsSuperseded(
+    const _FieldWrites& writes,
+    const SdfPath& path,
+    const TfToken& field,
+    std::size_t sequence)
+{
+    // Writes before namespace edit could belong to other spec, which was moved away since
+    auto it = writes.find({ path, field });
+    return it != writes.end() && sequence < it->second.sequence && sequence >= it->second.barrier;
+}
+
+void
+RenderStudioData::AccumulateRemoteUpdate(
+    _DeltaTable&& deltas,
+    std::vector<RenderStudio::API::NamespaceEdit>&& namespaceEdits,
+    std::size_t sequence,
+    std::size_t lastSequence)
+{
+    std::unique_lock<std::mutex> lock(mRemoteMutex);
+
+    // Already applied, same sequences come again on rejoin or history replay
+    if (sequence <= mLatestAppliedSequence)
+    {
+        LOG_DEBUG << "Skip already applied update: " << sequence;
+        return;
+    }
+    mRemoteDeltasQueue[sequence] = _RemoteUpdate { std::move(deltas), std::move(namespaceEdits), lastSequence };
+}
+
+RenderStudioData::_DeltaTable
+RenderStudioData::FetchLocalDeltas(bool includeInteractive)
+{
+    _CompactLocalDeltas();
+
+    _DeltaTable deltas;
+    deltas.swap(mLocalDeltas);
+
+    // Interactive edits stay pending until user stops, they're relayed as ephemeral meanwhile
+    if (!includeInteractive)
+    {
+        for (auto it = deltas.begin(); it != deltas.end();)
+        {
+            if (_IsInteractiveDelta(it->first, it->second))
+            {
+                mLocalDeltas.emplace(it->first, std::move(it->second));
+                it = deltas.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (const auto& [path, spec] : deltas)
+    {
+        mLocalDeltaRevisions.erase(path);
+    }
+
+    return deltas;
+}
+
+RenderStudioData::_DeltaTable
+RenderStudioData::CollectEphemeralDeltas()
+{
+    _DeltaTable deltas;
+
+    for (const auto& [path, spec] : mLocalDeltas)
+    {
+        if (!_IsInteractiveDelta(path, spec))
+        {
+            continue;
+        }
+
+        // Others already have the value relayed before, unless it was edited since
+        auto revision = mLocalDeltaRevisions.find(path);
+        if (revision != mLocalDeltaRevisions.end() && revision->second <= mEphemeralRevision)
+        {
+            continue;
+        }
+
+        // Pending delta itself is kept for final send, values are shared, not deep copied
+        RenderStudio::API::SpecData& copy = deltas[path];
+        copy.specType = spec.specType;
+        copy.fields = spec.fields;
+        copy.timeSamples = spec.timeSamples;
+    }
+
+    mEphemeralRevision = mLocalRevision;
+    return deltas;
+}
+
+RenderStudioData::_DeltaTable
+RenderStudioData::CollectJournalDeltas() const
+{
+    _DeltaTable deltas;
+
+    // Diffs are made only when deltas are fetched, so pending fields hold full latest values
+    for (const auto& [path, spec] : mLocalDeltas)
+    {
+        RenderStudio::API::SpecData& copy = deltas[path];
+        copy.specType = spec.specType;
+        copy.fields = spec.fields;
+        copy.timeSamples = spec.timeSamples;
+    }
+
+    return deltas;
+}
+
+void
+RenderStudioData::RestoreJournalDeltas(SdfLayerHandle& layer, const RenderStudio::API::DeltaEvent& journal)
+{
+    // Edits go through the layer as if user made them again, so they're recorded as local deltas and sent
+    std::optional<SdfChangeBlock> block;
+    block.emplace();
+    _NoticeList notices;
+
+    for (const RenderStudio::API::NamespaceEdit& edit : journal.namespaceEdits)
+    {
+        ApplyNamespaceEdit(layer, notices, edit);
+    }
+
+    for (const auto& [path, spec] : journal.updates)
+    {
+        if (layer->GetSpecType(path) == SdfSpecTypeUnknown)
+        {
+            if (spec.specType == SdfSpecTypeUnknown)
+            {
+                continue;
+            }
+
+            layer->GetStateDelegate()->CreateSpec(path, spec.specType, false);
+        }
+
+        for (const std::pair<TfToken, VtValue>& field : spec.fields)
+        {
+            layer->GetStateDelegate()->SetField(path, field.first, field.second);
+        }
+
+        for (const RenderStudio::API::TimeSampleOp& op : spec.timeSamples)
+        {
+            layer->GetStateDelegate()->SetTimeSample(path, op.time, op.value);
+        }
+
+        notices.push_back(RenderStudioNotice::PrimitiveChanged(path, path.IsPrimPath()));
+    }
+
+    block.reset();
+    SendNotices(notices, std::pmr::get_default_resource());
+    _PublishSnapshot();
+}
+
+void
+RenderStudioData::AccumulateEphemeralUpdate(_DeltaTable&& deltas)
+{
+    std::unique_lock<std::mutex> lock(mRemoteMutex);
+
+    // Only latest value of each attribute matters
+    for (auto& [path, spec] : deltas)
+    {
+        mRemoteEphemeral[path] = std::move(spec);
+    }
+}
+
+std::vector<RenderStudio::API::NamespaceEdit>
+RenderStudioData::FetchLocalNamespaceEdits()
+{
+    for (const RenderStudio::API::NamespaceEdit& edit : mLocalNamespaceEdits)
+    {
+        mUnacknowledgedNamespaceEdits.insert(edit.path);
+    }
+
+    std::vector<RenderStudio::API::NamespaceEdit> edits;
+    edits.swap(mLocalNamespaceEdits);
+    return edits;
+}
+
+void
+RenderStudioData::_RecordNamespaceEdit(const RenderStudio::API::NamespaceEdit& edit)
+{
+    if (mIsProcessingRemoteUpdates || !mIsLoaded)
+    {
+        return;
+    }
+
+    _MarkLayerDirty();
+    mLocalRevision += 1;
+
+    using Type = RenderStudio::API::NamespaceEdit::Type;
+    const bool isMove = edit.type == Type::Move;
+
+    // Pending deltas follow the spec: erased ones are dropped, moved ones are sent for new path
+    _DeltaTable::iterator delta = mLocalDeltas.find(edit.path);
+    if (delta != mLocalDeltas.end())
+    {
+        RenderStudio::API::SpecData moved = std::move(delta->second);
+        mLocalDeltas.erase(delta);
+        mLocalDeltaRevisions.erase(edit.path);
+
+        if (isMove)
+        {
+            mLocalDeltas[edit.newPath] = std::move(moved);
+            mLocalDeltaRevisions[edit.newPath] = mLocalRevision;
+        }
+    }
+
+    auto base = mLocalDeltaBases.lower_bound({ edit.path, TfToken() });
+    while (base != mLocalDeltaBases.end() && base->first.first == edit.path)
+    {
+        if (isMove)
+        {
+            mLocalDeltaBases[{ edit.newPath, base->first.second }] = std::move(base->second);
+        }
+
+        base = mLocalDeltaBases.erase(base);
+    }
+
+    // Checks if edit of descendant is implied by edit of its ancestor
+    auto covers = [](const RenderStudio::API::NamespaceEdit& ancestor, const RenderStudio::API::NamespaceEdit& other)
+    {
+        return ancestor.type == other.type && other.path != ancestor.path && other.path.HasPrefix(ancestor.path)
+            && (ancestor.type == Type::Erase
+                || other.newPath == other.path.ReplacePrefix(ancestor.path, ancestor.newPath));
+    };
+
+    // USD erases and moves subtree spec by spec, children first. Collapse them into single edit of subtree root
+    while (!mLocalNamespaceEdits.empty() && covers(edit, mLocalNamespaceEdits.back()))
+    {
+        mLocalNamespaceEdits.pop_back();
+    }
+
+    // Parent first order, edit is already covered by the last one
+    if (!mLocalNamespaceEdits.empty() && covers(mLocalNamespaceEdits.back(), edit))
+    {
+        return;
+    }
+
+    mLocalNamespaceEdits.push_back(edit);
+}
+
+void
+RenderStudioData::_MarkLayerDirty()
+{
+    // Layer with pending deltas is kept dirty by live update until they're sent, only first edit marks it
+    if (mLayerRegistry != nullptr && !HasLocalDeltas())
+    {
+        mLayerRegistry->MarkDirty(mIdentifier);
+    }
+}
+
+bool
+RenderStudioData::_IsUnderUnacknowledgedNamespaceEdit(const SdfPath& path) const
+{
+    if (mUnacknowledgedNamespaceEdits.empty())
+    {
+        return false;
+    }
+
+    for (SdfPath prefix = path; !prefix.IsEmpty(); prefix = prefix.GetParentPath())
+    {
+        if (mUnacknowledgedNamespaceEdits.count(prefix) > 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+RenderStudioData::AdoptFrom(const SdfAbstractDataPtr& source)
+{
+    TfAutoMallocTag2 tag("Sdf", "RenderStudioData::AdoptFrom");
+
+    std::vector<SdfPath> paths;
+    _SpecPathVisitor visitor(
+        [&paths](const SdfPath& path)
+        {
+            paths.push_back(path);
+            return true;
+        });
+    source->VisitSpecs(&visitor);
+    mData.reserve(mData.size() + paths.size());
+
+    for (const SdfPath& path : paths)
+    {
+        CreateSpec(path, source->GetSpecType(path));
+        _SpecData& spec = mData.at(path);
+
+        for (const TfToken& field : source->List(path))
+        {
+            // Values are shared, not deep copied. Array buffers are refcounted
+            VtValue& value = spec.fields.FindOrCreate(field);
+            value = source->Get(path, field);
+            RenderStudioValuePool::GetInstance().Intern(value);
+        }
+
+        _AdoptTimeSamples(spec);
+        if (spec.timeSamples)
+        {
+            _IndexTimeSamples(*spec.timeSamples, true);
+        }
+        _AccountFields(spec, true);
+
+        // Release source spec right away, so we hold one spec table at a time instead of two full ones
+        source->EraseSpec(path);
+    }
+}
+
+bool
+RenderStudioData::AttachBackingData(const SdfAbstractDataRefPtr& backing, const std::string& path)
+{
+    // Snapshots need every spec in own table, which defeats streaming
+    if (mSnapshotsEnabled)
+    {
+        return false;
+    }
+
+    mBackingData = backing;
+    mBackingPath = path;
+    mDetachedBackingSpecs.clear();
+
+    // Only sample times are read here, crate keeps them apart from values
+    _ForEachBackingSpec(
+        [this](const SdfPath& specPath)
+        {
+            for (double time : mBackingData->ListTimeSamplesForPath(specPath))
+            {
+                _AddTime(time);
+            }
+            return true;
+        });
+
+    return true;
+}
+
+void
+RenderStudioData::DetachBackingData()
+{
+    if (mBackingData == nullptr)
+    {
+        return;
+    }
+
+    std::vector<SdfPath> paths;
+    _ForEachBackingSpec(
+        [&paths](const SdfPath& path)
+        {
+            paths.push_back(path);
+            return true;
+        });
+    mData.reserve(mData.size() + paths.size());
+
+    for (const SdfPath& path : paths)
+    {
+        _MaterializeSpec(path);
+    }
+
+    mBackingData = TfNullPtr;
+    mBackingPath.clear();
+    mDetachedBackingSpecs.clear();
+}
+
+RenderStudioData::_HashTable::iterator
+RenderStudioData::_MaterializeSpec(const SdfPath& path)
+{
+    _HashTable::iterator i = mData.find(path);
+    if (i != mData.end())
+    {
+        return i;
+    }
+
+    const SdfAbstractData* backing = _GetBackingData(path);
+    SdfSpecType specType = backing ? backing->GetSpecType(path) : SdfSpecTypeUnknown;
+    if (specType == SdfSpecTypeUnknown)
+    {
+        return mData.end();
+    }
+
+    // Backing spec is hidden from now on, own copy takes its place
+    mDetachedBackingSpecs.insert(path);
+    CreateSpec(path, specType);
+
+    i = mData.find(path);
+    for (const TfToken& field : backing->List(path))
+    {
+        VtValue& value = i->second.fields.FindOrCreate(field);
+        value = backing->Get(path, field);
+        RenderStudioValuePool::GetInstance().Intern(value);
+    }
+
+    // Sample times were indexed on attach already
+    _AdoptTimeSamples(i->second);
+    _AccountFields(i->second, true);
+
+    return i;
+}
+
+const SdfAbstractData*
+RenderStudioData::_GetBackingData(const SdfPath& path) const
+{
+    if (mBackingData == nullptr || mData.find(path) != mData.end() || mDetachedBackingSpecs.count(path) > 0)
+    {
+        return nullptr;
+    }
+
+    return get_pointer(mBackingData);
+}
+
+void
+RenderStudioData::_ForEachBackingSpec(const std::function<bool(const SdfPath&)>& fn) const
+{
+    if (mBackingData == nullptr)
+    {
+        return;
+    }
+
+    // Detached specs are skipped, but visiting goes on
+    _SpecPathVisitor visitor(
+        [this, &fn](const SdfPath& path) { return mDetachedBackingSpecs.count(path) > 0 || fn(path); });
+    mBackingData->VisitSpecs(&visitor);
+}
+
+void
+RenderStudioData::_AddTime(double time)
+{
+    mTimeIndex[time] += 1;
+}
+
+void
+RenderStudioData::_RemoveTime(double time)
+{
+    auto it = mTimeIndex.find(time);
+    if (it == mTimeIndex.end())
+    {
+        return;
+    }
+
+    if (--it->second == 0)
+    {
+        mTimeIndex.erase(it);
+    }
+}
+
+void
+RenderStudioData::_IndexTimeSamples(const RenderStudioTimeSamples& samples, bool add)
+{
+    for (double time : samples.GetTimes())
+    {
+        add ? _AddTime(time) : _RemoveTime(time);
+    }
+}
+
+void
+RenderStudioData::_AccountFields(const _SpecData& spec, bool add)
+{
+    for (std::size_t i = 0; i < spec.fields.size(); i++)
+    {
+        add ? mStats.AddValue(spec.specType, spec.fields.GetKey(i), spec.fields.GetValue(i))
+            : mStats.RemoveValue(spec.specType, spec.fields.GetKey(i), spec.fields.GetValue(i));
+    }
+
+    _AccountTimeSamples(spec, add);
+}
+
+void
+RenderStudioData::_AccountTimeSamples(const _SpecData& spec, bool add)
+{
+    if (!spec.timeSamples)
+    {
+        return;
+    }
+
+    for (const VtValue& value : spec.timeSamples->GetValues())
+    {
+        add ? mStats.AddValue(spec.specType, SdfDataTokens->TimeSamples, value)
+            : mStats.RemoveValue(spec.specType, SdfDataTokens->TimeSamples, value);
+    }
+}
+
+void
+RenderStudioData::_AdoptTimeSamples(_SpecData& spec)
+{
+    const VtValue* value = spec.fields.Find(SdfDataTokens->TimeSamples);
+    if (value == nullptr || !value->IsHolding<SdfTimeSampleMap>())
+    {
+        return;
+    }
+
+    spec.timeSamples = std::make_unique<RenderStudioTimeSamples>(value->UncheckedGet<SdfTimeSampleMap>());
+    spec.fields.Erase(SdfDataTokens->TimeSamples);
+}
+
+const RenderStudioTimeSamples*
+RenderStudioData::_GetTimeSamples(const SdfPath& path) const
+{
+    _HashTable::const_iterator i = mData.find(path);
+    return i != mData.end() ? i->second.timeSamples.get() : nullptr;
+}
+
+void
+RenderStudioData::_SetTimeSamples(const SdfPath& path, const SdfTimeSampleMap& samples)
+{
+    _HashTable::iterator i = _MaterializeSpec(path);
+    if (!TF_VERIFY(i != mData.end(), "No spec at <%s> when trying to set time samples", path.GetText()))
+    {
+        return;
+    }
+
+    _SpecData& spec = i->second;
+    if (spec.timeSamples)
+    {
+        _IndexTimeSamples(*spec.timeSamples, false);
+        _AccountTimeSamples(spec, false);
+    }
+
+    spec.fields.Erase(SdfDataTokens->TimeSamples);
+    spec.timeSamples = std::make_unique<RenderStudioTimeSamples>(samples);
+    _IndexTimeSamples(*spec.timeSamples, true);
+    _AccountTimeSamples(spec, true);
+    _MarkDirty(path);
+}
+
+void
+RenderStudioData::OnLoaded()
+{
+    mIsLoaded = true;
+    mLocalDeltas.clear();
+    mLocalDeltaRevisions.clear();
+    mEphemeralRevision = 0;
+    mLocalDeltaBases.clear();
+    mPendingFullResends.clear();
+    mPendingLocalChildren.clear();
+    mPendingLocalKeys.clear();
+    mLocalNamespaceEdits.clear();
+    mUnacknowledgedNamespaceEdits.clear();
+    mUnacknowledgedFields.clear();
+    mLatestAppliedSequence = 0;
+    mRemoteDeltasQueue.clear();
+    mRemoteEphemeral.clear();
+
+    mSnapshot.reset();
+    mSnapshotDirtyPaths.clear();
+    _PublishSnapshot();
+}
+
+std::size_t
+RenderStudioData::GetRemoteQueueSize() const
+{
+    std::lock_guard<std::mutex> lock(mRemoteMutex);
+    return mRemoteDeltasQueue.size();
+}
+
+std::shared_ptr<const RenderStudioDataSnapshot>
+RenderStudioData::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(mSnapshotMutex);
+    return mSnapshot;
+}
+
+void
+RenderStudioData::_MarkDirty(const SdfPath& path)
+{
+    if (mSnapshotsEnabled)
+    {
+        mSnapshotDirtyPaths.insert(path);
+    }
+}
+
+void
+RenderStudioData::_PublishSnapshot()
+{
+    if (!mSnapshotsEnabled)
+    {
+        return;
+    }
+
+    std::shared_ptr<const RenderStudioDataSnapshot> previous = GetSnapshot();
+    if (previous && mSnapshotDirtyPaths.empty() && previous->GetSequence() == mLatestAppliedSequence)
+    {
+        return;
+    }
+
+    auto makeSpec = [](const _SpecData& spec)
+    {
+        // Fields copy only shares storage, it's detached when spec is changed next time
+        RenderStudioDataSnapshot::Spec copy { spec.specType, spec.fields };
+        if (spec.timeSamples)
+        {
+            copy.timeSamples = spec.timeSamples->GetMapValue();
+        }
+        return std::make_shared<const RenderStudioDataSnapshot::Spec>(std::move(copy));
+    };
+
+    RenderStudioDataSnapshot::Builder builder(previous);
+
+    if (previous == nullptr)
+    {
+        for (const auto& [path, spec] : mData)
+        {
+            builder.SetSpec(path, makeSpec(spec));
+        }
+    }
+    else
+    {
+        for (const SdfPath& path : mSnapshotDirtyPaths)
+        {
+            _HashTable::const_iterator i = mData.find(path);
+            if (i != mData.end())
+            {
+                builder.SetSpec(path, makeSpec(i->second));
+            }
+            else
+            {
+                builder.EraseSpec(path);
+            }
+        }
+    }
+
+    mSnapshotDirtyPaths.clear();
+    std::shared_ptr<const RenderStudioDataSnapshot> next = builder.Build(mLatestAppliedSequence);
+
+    std::lock_guard<std::mutex> lock(mSnapshotMutex);
+    mSnapshot = std::move(next);
+}
+
+bool
+RenderStudioData::StreamsData() const
+{
+    return mBackingData != nullptr;
+}
+
+bool
+RenderStudioData::HasSpec(const SdfPath& path) const
+{
+    if (mData.find(path) != mData.end())
+    {
+        return true;
+    }
+
+    const SdfAbstractData* backing = _GetBackingData(path);
+    return backing && backing->HasSpec(path);
+}
+
+void
+RenderStudioData::EraseSpec(const SdfPath& path)
+{
+    // Layer erases remote subtree spec by spec, whole subtree goes at once on first call
+    using Type = RenderStudio::API::NamespaceEdit::Type;
+    if (mRemoteNamespaceEdit != nullptr && mRemoteNamespaceEdit->type == Type::Erase
+        && path.HasPrefix(mRemoteNamespaceEdit->path))
+    {
+        if (HasSpec(mRemoteNamespaceEdit->path))
+        {
+            EraseSubtree(mRemoteNamespaceEdit->path);
+        }
+        return;
+    }
+
+    _RecordNamespaceEdit({ Type::Erase, path, SdfPath() });
+
+    _HashTable::iterator i = mData.find(path);
+    if (mHierarchyIndexEnabled && i != mData.end())
+    {
+        _UnlinkChild(path, i->second);
+    }
+
+    TF_VERIFY(_DropSpec(path), "No spec to erase at <%s>", path.GetText());
+}
+
+bool
+RenderStudioData::_DropSpec(const SdfPath& path)
+{
+    _MarkDirty(path);
+
+    // Untouched backing spec is just hidden
+    const SdfAbstractData* backing = _GetBackingData(path);
+    if (backing && backing->HasSpec(path))
+    {
+        for (double time : backing->ListTimeSamplesForPath(path))
+        {
+            _RemoveTime(time);
+        }
+
+        mDetachedBackingSpecs.insert(path);
+        return true;
+    }
+
+    _HashTable::iterator i = mData.find(path);
+    if (i == mData.end())
+    {
+        return false;
+    }
+
+    if (i->second.timeSamples)
+    {
+        _IndexTimeSamples(*i->second.timeSamples, false);
+    }
+
+    _AccountFields(i->second, false);
+    mStats.RemoveSpec(i->second.specType, sizeof(_HashTable::value_type));
+    mData.erase(i);
+    return true;
+}
+
+void
+RenderStudioData::MoveSpec(const SdfPath& oldPath, const SdfPath& newPath)
+{
+    // Layer moves remote subtree spec by spec, whole subtree goes at once on first call
+    using Type = RenderStudio::API::NamespaceEdit::Type;
+    if (mRemoteNamespaceEdit != nullptr && mRemoteNamespaceEdit->type == Type::Move
+        && oldPath.HasPrefix(mRemoteNamespaceEdit->path))
+    {
+        if (HasSpec(mRemoteNamespaceEdit->path))
+        {
+            MoveSubtree(mRemoteNamespaceEdit->path, mRemoteNamespaceEdit->newPath);
+        }
+        return;
+    }
+
+    if (!TF_VERIFY(!HasSpec(newPath)))
+    {
+        return;
+    }
+
+    _HashTable::iterator old = _MaterializeSpec(oldPath);
+    if (!TF_VERIFY(old != mData.end(), "No spec to move at <%s>", oldPath.GetString().c_str()))
+    {
+        return;
+    }
+
+    _RecordNamespaceEdit({ Type::Move, oldPath, newPath });
+
+    if (mHierarchyIndexEnabled)
+    {
+        _UnlinkChild(oldPath, old->second);
+    }
+
+    // Flat table may relocate entries on insertion, so detach value before
+    _SpecData spec = std::move(old->second);
+    mData.erase(old);
+    auto inserted = mData.insert(std::make_pair(newPath, std::move(spec)));
+
+    if (mHierarchyIndexEnabled)
+    {
+        _LinkChild(newPath, inserted.first->second);
+    }
+
+    _MarkDirty(oldPath);
+    _MarkDirty(newPath);
+}
+
+void
+RenderStudioData::EraseSubtree(const SdfPath& path)
+{
+    std::vector<SdfPath> subtree;
+    _CollectSubtree(path, subtree);
+
+    if (subtree.empty())
+    {
+        return;
+    }
+
+    _RecordNamespaceEdit({ RenderStudio::API::NamespaceEdit::Type::Erase, path, SdfPath() });
+
+    // Only subtree root is unlinked from its parent, children lists inside subtree are dropped as a whole
+    _HashTable::iterator root = mData.find(path);
+    if (mHierarchyIndexEnabled && root != mData.end())
+    {
+        _UnlinkChild(path, root->second);
+    }
+
+    for (const SdfPath& specPath : subtree)
+    {
+        _DropSpec(specPath);
+
+        if (mHierarchyIndexEnabled)
+        {
+            mChildren.erase(specPath);
+        }
+    }
+
+    mSubtreeEditCount += 1;
+}
+
+void
+RenderStudioData::MoveSubtree(const SdfPath& oldPath, const SdfPath& newPath)
+{
+    if (!TF_VERIFY(!HasSpec(newPath), "Can't move <%s> to existing spec <%s>", oldPath.GetText(), newPath.GetText()))
+    {
+        return;
+    }
+
+    std::vector<SdfPath> subtree;
+    _CollectSubtree(oldPath, subtree);
+
+    if (subtree.empty())
+    {
+        return;
+    }
+
+    _RecordNamespaceEdit({ RenderStudio::API::NamespaceEdit::Type::Move, oldPath, newPath });
+
+    // Backing specs can't be moved, they're copied into own table first
+    for (const SdfPath& specPath : subtree)
+    {
+        _MaterializeSpec(specPath);
+    }
+
+    // Only subtree root changes its parent. Descendants keep their positions among siblings,
+    // so their children lists are carried over as they are
+    _HashTable::iterator root = mData.find(oldPath);
+    if (mHierarchyIndexEnabled && root != mData.end())
+    {
+        _UnlinkChild(oldPath, root->second);
+    }
+
+    for (const SdfPath& specPath : subtree)
+    {
+        SdfPath movedPath = specPath.ReplacePrefix(oldPath, newPath);
+
+        // Values are moved, not copied, so cost doesn't depend on amount of data inside specs
+        _HashTable::iterator i = mData.find(specPath);
+        if (i != mData.end())
+        {
+            _SpecData spec = std::move(i->second);
+            mData.erase(i);
+            mData.insert(std::make_pair(movedPath, std::move(spec)));
+        }
+
+        if (mHierarchyIndexEnabled)
+        {
+            _ChildrenTable::iterator children = mChildren.find(specPath);
+            if (children != mChildren.end())
+            {
+                std::vector<SdfPath> moved = std::move(children->second);
+                mChildren.erase(children);
+
+                for (SdfPath& child : moved)
+                {
+                    child = child.ReplacePrefix(oldPath, newPath);
+                }
+
+                mChildren.insert(std::make_pair(movedPath, std::move(moved)));
+            }
+        }
+
+        _MarkDirty(specPath);
+        _MarkDirty(movedPath);
+    }
+
+    root = mData.find(newPath);
+    if (mHierarchyIndexEnabled && root != mData.end())
+    {
+        _LinkChild(newPath, root->second);
+    }
+
+    mSubtreeEditCount += 1;
+}
+
+std::vector<SdfPath>
+RenderStudioData::ListChildren(const SdfPath& path) const
+{
+    if (mHierarchyIndexEnabled && mBackingData == nullptr)
+    {
+        _ChildrenTable::const_iterator i = mChildren.find(path);
+        return i != mChildren.end() ? i->second : std::vector<SdfPath> {};
+    }
+
+    std::vector<SdfPath> children;
+    for (const auto& [specPath, spec] : mData)
+    {
+        if (specPath.GetParentPath() == path)
+        {
+            children.push_back(specPath);
+        }
+    }
+
+    // Backing data has no index, untouched specs are found by scan
+    _ForEachBackingSpec(
+        [&children, &path](const SdfPath& specPath)
+        {
+            if (specPath.GetParentPath() == path)
+            {
+                children.push_back(specPath);
+            }
+            return true;
+        });
+
+    return children;
+}
+
+void
+RenderStudioData::_LinkChild(const SdfPath& path, _SpecData& spec)
+{
+    if (path == SdfPath::AbsoluteRootPath())
+    {
+        return;
+    }
+
+    std::vector<SdfPath>& siblings = mChildren[path.GetParentPath()];
+    spec.childIndex = static_cast<std::uint32_t>(siblings.size());
+    siblings.push_back(path);
+}
+
+void
+RenderStudioData::_UnlinkChild(const SdfPath& path, const _SpecData& spec)
+{
+    if (path == SdfPath::AbsoluteRootPath())
+    {
+        return;
+    }
+
+    _ChildrenTable::iterator i = mChildren.find(path.GetParentPath());
+    if (!TF_VERIFY(i != mChildren.end() && spec.childIndex < i->second.size()))
+    {
+        return;
+    }
+
+    // Swap with last sibling, so unlinking is O(1) even for huge scopes
+    std::vector<SdfPath>& siblings = i->second;
+    if (spec.childIndex + 1 != siblings.size())
+    {
+        SdfPath last = siblings.back();
+        siblings[spec.childIndex] = last;
+        mData.at(last).childIndex = spec.childIndex;
+    }
+
+    siblings.pop_back();
+
+    if (siblings.empty())
+    {
+        mChildren.erase(i);
+    }
+}
+
+void
+RenderStudioData::_CollectSubtree(const SdfPath& path, std::vector<SdfPath>& result) const
+{
+    _ForEachBackingSpec(
+        [&result, &path](const SdfPath& specPath)
+        {
+            if (specPath.HasPrefix(path))
+            {
+                result.push_back(specPath);
+            }
+            return true;
+        });
+
+    // Backing specs aren't linked into index, so walk would stop at untouched ancestor of materialized spec
+    if (!mHierarchyIndexEnabled || mBackingData != nullptr)
+    {
+        for (const auto& [specPath, spec] : mData)
+        {
+            if (specPath.HasPrefix(path))
+            {
+                result.push_back(specPath);
+            }
+        }
+        return;
+    }
+
+    // Depth first walk over index, parents always precede their descendants
+    std::vector<SdfPath> stack { path };
+    while (!stack.empty())
+    {
+        SdfPath current = std::move(stack.back());
+        stack.pop_back();
+
+        if (mData.find(current) != mData.end())
+        {
+            result.push_back(current);
+        }
+
+        _ChildrenTable::const_iterator i = mChildren.find(current);
+        if (i != mChildren.end())
+        {
+            stack.insert(stack.end(), i->second.begin(), i->second.end());
+        }
+    }
+}
+
+SdfSpecType
+RenderStudioData::GetSpecType(const SdfPath& path) const
+{
+    _HashTable::const_iterator i = mData.find(path);
+    if (i == mData.end())
+    {
+        const SdfAbstractData* backing = _GetBackingData(path);
+        return backing ? backing->GetSpecType(path) : SdfSpecTypeUnknown;
+    }
+    return i->second.specType;
+}
+
+void
+RenderStudioData::CreateSpec(const SdfPath& path, SdfSpecType specType)
+{
+    if (!TF_VERIFY(specType != SdfSpecTypeUnknown))
+    {
+        return;
+    }
+
+    _MaterializeSpec(path);
+
+    auto [i, inserted] = mData.try_emplace(path);
+    if (inserted)
+    {
+        mStats.AddSpec(specType, sizeof(_HashTable::value_type));
+    }
+    else if (i->second.specType != specType)
+    {
+        // Values are accounted under the type of their spec
+        _AccountFields(i->second, false);
+        mStats.RemoveSpec(i->second.specType, sizeof(_HashTable::value_type));
+        mStats.AddSpec(specType, sizeof(_HashTable::value_type));
+        i->second.specType = specType;
+        _AccountFields(i->second, true);
+    }
+
+    i->second.specType = specType;
+
+    if (inserted && mHierarchyIndexEnabled)
+    {
+        _LinkChild(path, i->second);
+    }
+
+    _MarkDirty(path);
+}
+
+void
+RenderStudioData::_VisitSpecs(SdfAbstractDataSpecVisitor* visitor) const
+{
+    for (const auto& [path, spec] : mData)
+    {
+        if (!visitor->VisitSpec(*this, path))
+        {
+            return;
+        }
+    }
+
+    _ForEachBackingSpec([this, visitor](const SdfPath& path) { return visitor->VisitSpec(*this, path); });
+}
+
+bool
+RenderStudioData::Has(const SdfPath& path, const TfToken& field, SdfAbstractDataValue* value) const
+{
+    if (field == SdfDataTokens->TimeSamples)
+    {
+        if (const RenderStudioTimeSamples* samples = _GetTimeSamples(path))
+        {
+            return !value || value->StoreValue(samples->GetMapValue());
+        }
     }
-}
 
-bool
-RenderStudioData::Has(const SdfPath& path, const TfToken& field, SdfAbstractDataValue* value) const
-{
     if (const VtValue* fieldValue = _GetFieldValue(path, field))
     {
         if (value)
@@ -341,12 +1800,26 @@ RenderStudioData::Has(const SdfPath& path, const TfToken& field, SdfAbstractData
         }
         return true;
     }
-    return false;
+
+    const SdfAbstractData* backing = _GetBackingData(path);
+    return backing && backing->Has(path, field, value);
 }
 
 bool
 RenderStudioData::Has(const SdfPath& path, const TfToken& field, VtValue* value) const
 {
+    if (field == SdfDataTokens->TimeSamples)
+    {
+        if (const RenderStudioTimeSamples* samples = _GetTimeSamples(path))
+        {
+            if (value)
+            {
+                *value = samples->GetMapValue();
+            }
+            return true;
+        }
+    }
+
     if (const VtValue* fieldValue = _GetFieldValue(path, field))
     {
         if (value)
@@ -355,7 +1828,9 @@ RenderStudioData::Has(const SdfPath& path, const TfToken& field, VtValue* value)
         }
         return true;
     }
-    return false;
+
+    const SdfAbstractData* backing = _GetBackingData(path);
+    return backing && backing->Has(path, field, value);
 }
 
 bool
@@ -365,17 +1840,43 @@ RenderStudioData::HasSpecAndField(
     SdfAbstractDataValue* value,
     SdfSpecType* specType) const
 {
+    if (fieldName == SdfDataTokens->TimeSamples)
+    {
+        _HashTable::const_iterator i = mData.find(path);
+        if (i != mData.end() && i->second.timeSamples)
+        {
+            *specType = i->second.specType;
+            return !value || value->StoreValue(i->second.timeSamples->GetMapValue());
+        }
+    }
+
     if (VtValue const* v = _GetSpecTypeAndFieldValue(path, fieldName, specType))
     {
         return !value || value->StoreValue(*v);
     }
-    return false;
+
+    const SdfAbstractData* backing = *specType == SdfSpecTypeUnknown ? _GetBackingData(path) : nullptr;
+    return backing && backing->HasSpecAndField(path, fieldName, value, specType);
 }
 
 bool
 RenderStudioData::HasSpecAndField(const SdfPath& path, const TfToken& fieldName, VtValue* value, SdfSpecType* specType)
     const
 {
+    if (fieldName == SdfDataTokens->TimeSamples)
+    {
+        _HashTable::const_iterator i = mData.find(path);
+        if (i != mData.end() && i->second.timeSamples)
+        {
+            *specType = i->second.specType;
+            if (value)
+            {
+                *value = i->second.timeSamples->GetMapValue();
+            }
+            return true;
+        }
+    }
+
     if (VtValue const* v = _GetSpecTypeAndFieldValue(path, fieldName, specType))
     {
         if (value)
@@ -384,7 +1885,9 @@ RenderStudioData::HasSpecAndField(const SdfPath& path, const TfToken& fieldName,
         }
         return true;
     }
-    return false;
+
+    const SdfAbstractData* backing = *specType == SdfSpecTypeUnknown ? _GetBackingData(path) : nullptr;
+    return backing && backing->HasSpecAndField(path, fieldName, value, specType);
 }
 
 const VtValue*
@@ -399,13 +1902,7 @@ RenderStudioData::_GetSpecTypeAndFieldValue(const SdfPath& path, const TfToken&
     {
         const _SpecData& spec = i->second;
         *specType = spec.specType;
-        for (auto const& f : spec.fields)
-        {
-            if (f.first == field)
-            {
-                return &f.second;
-            }
-        }
+        return spec.fields.Find(field);
     }
     return nullptr;
 }
@@ -416,44 +1913,29 @@ RenderStudioData::_GetFieldValue(const SdfPath& path, const TfToken& field) cons
     _HashTable::const_iterator i = mData.find(path);
     if (i != mData.end())
     {
-        const _SpecData& spec = i->second;
-        for (auto const& f : spec.fields)
-        {
-            if (f.first == field)
-            {
-                return &f.second;
-            }
-        }
+        return i->second.fields.Find(field);
     }
     return nullptr;
 }
 
-VtValue*
-RenderStudioData::_GetMutableFieldValue(const SdfPath& path, const TfToken& field)
+VtValue
+RenderStudioData::Get(const SdfPath& path, const TfToken& field) const
 {
-    _HashTable::iterator i = mData.find(path);
-    if (i != mData.end())
+    if (field == SdfDataTokens->TimeSamples)
     {
-        _SpecData& spec = i->second;
-        for (size_t j = 0, jEnd = spec.fields.size(); j != jEnd; ++j)
+        if (const RenderStudioTimeSamples* samples = _GetTimeSamples(path))
         {
-            if (spec.fields[j].first == field)
-            {
-                return &spec.fields[j].second;
-            }
+            return samples->GetMapValue();
         }
     }
-    return NULL;
-}
 
-VtValue
-RenderStudioData::Get(const SdfPath& path, const TfToken& field) const
-{
     if (const VtValue* value = _GetFieldValue(path, field))
     {
         return *value;
     }
-    return VtValue();
+
+    const SdfAbstractData* backing = _GetBackingData(path);
+    return backing ? backing->Get(path, field) : VtValue();
 }
 
 void
@@ -468,11 +1950,19 @@ RenderStudioData::Set(const SdfPath& path, const TfToken& field, const VtValue&
     }
 
     // Default
-    VtValue* newValue = _GetOrCreateFieldValue(path, field);
-
-    if (newValue)
+    SdfSpecType specType = SdfSpecTypeUnknown;
+    if (field == SdfDataTokens->TimeSamples && value.IsHolding<SdfTimeSampleMap>())
+    {
+        _SetTimeSamples(path, value.UncheckedGet<SdfTimeSampleMap>());
+    }
+    else if (VtValue* newValue = _GetOrCreateFieldValue(path, field, &specType))
     {
+        _CaptureDeltaBase(path, field, *newValue);
+        mStats.RemoveValue(specType, field, *newValue);
         *newValue = value;
+        RenderStudioValuePool::GetInstance().Intern(*newValue);
+        mStats.AddValue(specType, field, *newValue);
+        _MarkDirty(path);
     }
 
     // USD calls Set() method while setting fields, we don't want to update local deltas in such case
@@ -494,11 +1984,26 @@ RenderStudioData::Set(const SdfPath& path, const TfToken& field, const SdfAbstra
 {
     TfAutoMallocTag2 tag("Sdf", "RenderStudioData::Set");
 
+    // Time samples are converted into own storage anyway
+    if (field == SdfDataTokens->TimeSamples)
+    {
+        VtValue copy;
+        value.GetValue(&copy);
+        Set(path, field, copy);
+        return;
+    }
+
     // Default
-    VtValue* newValue = _GetOrCreateFieldValue(path, field);
+    SdfSpecType specType = SdfSpecTypeUnknown;
+    VtValue* newValue = _GetOrCreateFieldValue(path, field, &specType);
     if (newValue)
     {
+        _CaptureDeltaBase(path, field, *newValue);
+        mStats.RemoveValue(specType, field, *newValue);
         value.GetValue(newValue);
+        RenderStudioValuePool::GetInstance().Intern(*newValue);
+        mStats.AddValue(specType, field, *newValue);
+        _MarkDirty(path);
     }
 
     // USD calls Set() method while setting fields, we don't want to update local deltas in such case
@@ -515,48 +2020,195 @@ RenderStudioData::Set(const SdfPath& path, const TfToken& field, const SdfAbstra
     }
 }
 
-VtValue*
-RenderStudioData::_GetOrCreateFieldValue(const SdfPath& path, const TfToken& field)
+void
+RenderStudioData::_CaptureDeltaBase(const SdfPath& path, const TfToken& field, const VtValue& previous)
 {
-    _HashTable::iterator i = mData.find(path);
-    if (!TF_VERIFY(i != mData.end(), "No spec at <%s> when trying to set field '%s'", path.GetText(), field.GetText()))
+    if (mIsProcessingRemoteUpdates || !mIsLoaded || !_IsPatchable(field, previous))
     {
-        return nullptr;
+        return;
     }
 
-    _SpecData& spec = i->second;
-    for (auto& f : spec.fields)
+    // Value before first edit since last send is what other clients have, buffer is shared, not copied
+    mLocalDeltaBases.try_emplace({ path, field }, previous);
+}
+
+void
+RenderStudioData::_RequestFullResend(const SdfPath& path, const TfToken& field)
+{
+    // Layer is sent on next live update even if user doesn't edit anything else
+    _MarkLayerDirty();
+    mPendingFullResends.insert({ path, field });
+}
+
+void
+RenderStudioData::_CompactLocalDeltas()
+{
+    // Arrays edited by other user at the same time are sent in full, diffs might have been dropped on their side
+    for (const auto& [path, field] : mPendingFullResends)
     {
-        if (f.first == field)
+        VtValue value = Get(path, field);
+        if (value.IsEmpty())
         {
-            return &f.second;
+            continue;
+        }
+
+        mLocalDeltaBases.erase({ path, field });
+        if (VtValue* delta = _GetOrCreateFieldValueDelta(path, field))
+        {
+            *delta = value;
         }
     }
 
-    spec.fields.emplace_back(std::piecewise_construct, std::forward_as_tuple(field), std::forward_as_tuple());
+    mPendingFullResends.clear();
 
-    return &spec.fields.back().second;
+    for (const auto& [key, base] : mLocalDeltaBases)
+    {
+        _DeltaTable::iterator i = mLocalDeltas.find(key.first);
+        if (i == mLocalDeltas.end())
+        {
+            continue;
+        }
+
+        auto& fields = i->second.fields;
+        auto field = std::find_if(fields.begin(), fields.end(), [&key](const std::pair<TfToken, VtValue>& f) {
+            return f.first == key.second;
+        });
+
+        if (field == fields.end())
+        {
+            continue;
+        }
+
+        if (_IsChildrenField(key.second))
+        {
+            if (!base.IsHolding<std::vector<TfToken>>() || !field->second.IsHolding<std::vector<TfToken>>())
+            {
+                continue;
+            }
+
+            std::optional<std::vector<RenderStudio::API::ChildrenOp>> ops = RenderStudioChildrenDiff::Compute(
+                key.second,
+                base.UncheckedGet<std::vector<TfToken>>(),
+                field->second.UncheckedGet<std::vector<TfToken>>());
+
+            if (ops.has_value())
+            {
+                auto& pending = mPendingLocalChildren[key];
+                for (RenderStudio::API::ChildrenOp& op : ops.value())
+                {
+                    if (op.type != RenderStudio::API::ChildrenOp::Type::Remove)
+                    {
+                        pending.insert(op.name);
+                    }
+
+                    i->second.childrenOps.push_back(std::move(op));
+                }
+
+                fields.erase(field);
+            }
+
+            continue;
+        }
+
+        if (base.IsHolding<VtDictionary>())
+        {
+            std::optional<std::vector<RenderStudio::API::DictionaryOp>> ops
+                = RenderStudioFieldPatch::ComputeDictionary(key.second, base, field->second);
+
+            if (ops.has_value())
+            {
+                auto& pending = mPendingLocalKeys[key];
+                for (RenderStudio::API::DictionaryOp& op : ops.value())
+                {
+                    pending.insert(op.key);
+                    i->second.dictionaryOps.push_back(std::move(op));
+                }
+
+                fields.erase(field);
+            }
+
+            continue;
+        }
+
+        if (RenderStudioFieldPatch::IsSupported(base))
+        {
+            std::optional<std::vector<RenderStudio::API::ListOpEdit>> edits
+                = RenderStudioFieldPatch::ComputeListOp(key.second, base, field->second);
+
+            if (edits.has_value())
+            {
+                std::move(edits->begin(), edits->end(), std::back_inserter(i->second.listOpEdits));
+                fields.erase(field);
+            }
+
+            continue;
+        }
+
+        std::optional<RenderStudio::API::ArrayDiff> diff = RenderStudioArrayDiff::Compute(base, field->second);
+        if (diff.has_value())
+        {
+            i->second.arrayDiffs.push_back({ field->first, std::move(diff.value()) });
+            fields.erase(field);
+        }
+    }
+
+    mLocalDeltaBases.clear();
 }
 
 VtValue*
-RenderStudioData::_GetOrCreateFieldValueDelta(const SdfPath& path, const TfToken& field)
+RenderStudioData::_GetOrCreateFieldValue(const SdfPath& path, const TfToken& field, SdfSpecType* specType)
+{
+    _HashTable::iterator i = _MaterializeSpec(path);
+    if (!TF_VERIFY(i != mData.end(), "No spec at <%s> when trying to set field '%s'", path.GetText(), field.GetText()))
+    {
+        return nullptr;
+    }
+
+    *specType = i->second.specType;
+    return &i->second.fields.FindOrCreate(field);
+}
+
+RenderStudio::API::SpecData*
+RenderStudioData::_GetOrCreateSpecDelta(const SdfPath& path)
 {
+    _MarkLayerDirty();
+    mLocalRevision += 1;
+
     // Apply spec type from mData to _deltas
-    if (mLocalDeltas.find(path) == mLocalDeltas.end())
+    _DeltaTable::iterator i = mLocalDeltas.find(path);
+    if (i == mLocalDeltas.end())
     {
-        _HashTable::iterator i = mData.find(path);
+        _HashTable::iterator spec = mData.find(path);
 
-        if (!TF_VERIFY(
-                i != mData.end(), "No spec at <%s> when trying to set field '%s'", path.GetText(), field.GetText()))
+        if (!TF_VERIFY(spec != mData.end(), "No spec at <%s> when trying to record delta", path.GetText()))
         {
             return nullptr;
         }
 
-        mLocalDeltas[path].specType = i->second.specType;
+        i = mLocalDeltas.insert({ path, RenderStudio::API::SpecData {} }).first;
+        i->second.specType = spec->second.specType;
     }
 
-    _HashTable::iterator i = mLocalDeltas.find(path);
-    _SpecData& spec = i->second;
+    mLocalDeltaRevisions[path] = mLocalRevision;
+    return &i->second;
+}
+
+VtValue*
+RenderStudioData::_GetOrCreateFieldValueDelta(const SdfPath& path, const TfToken& field)
+{
+    RenderStudio::API::SpecData* delta = _GetOrCreateSpecDelta(path);
+    if (delta == nullptr)
+    {
+        return nullptr;
+    }
+
+    RenderStudio::API::SpecData& spec = *delta;
+
+    // Whole samples map supersedes single sample edits made before
+    if (field == SdfDataTokens->TimeSamples)
+    {
+        spec.timeSamples.clear();
+    }
 
     for (auto& f : spec.fields)
     {
@@ -574,43 +2226,92 @@ RenderStudioData::_GetOrCreateFieldValueDelta(const SdfPath& path, const TfToken
     return &spec.fields.back().second;
 }
 
+void
+RenderStudioData::_RecordTimeSampleDelta(const SdfPath& path, double time, const VtValue& value)
+{
+    // Same as for fields, changes made by USD itself or by remote updates aren't recorded
+    if (mIsProcessingRemoteUpdates || !mIsLoaded)
+    {
+        return;
+    }
+
+    RenderStudio::API::SpecData* spec = _GetOrCreateSpecDelta(path);
+    if (spec == nullptr)
+    {
+        return;
+    }
+
+    // Only latest edit of the sample matters, edits of different samples don't depend on order
+    auto it = std::find_if(
+        spec->timeSamples.begin(),
+        spec->timeSamples.end(),
+        [time](const RenderStudio::API::TimeSampleOp& op) { return op.time == time; });
+
+    if (it != spec->timeSamples.end())
+    {
+        it->value = value;
+    }
+    else
+    {
+        spec->timeSamples.push_back(RenderStudio::API::TimeSampleOp { time, value });
+    }
+
+    mUnacknowledgedFields.insert(path);
+}
+
 void
 RenderStudioData::Erase(const SdfPath& path, const TfToken& field)
 {
-    _HashTable::iterator i = mData.find(path);
+    // Don't materialize backing spec if there's nothing to erase
+    const SdfAbstractData* backing = _GetBackingData(path);
+    if (backing && !backing->Has(path, field))
+    {
+        return;
+    }
+
+    _HashTable::iterator i = _MaterializeSpec(path);
     if (i == mData.end())
     {
         return;
     }
 
-    _SpecData& spec = i->second;
-    for (size_t j = 0, jEnd = spec.fields.size(); j != jEnd; ++j)
+    if (field == SdfDataTokens->TimeSamples && i->second.timeSamples)
     {
-        if (spec.fields[j].first == field)
-        {
-            spec.fields.erase(spec.fields.begin() + j);
-            return;
-        }
+        _IndexTimeSamples(*i->second.timeSamples, false);
+        _AccountTimeSamples(i->second, false);
+        i->second.timeSamples.reset();
+        _MarkDirty(path);
+    }
+
+    // USD pushes children by erasing the list and setting it back, keep the list before both as delta base
+    if (const VtValue* previous = i->second.fields.Find(field))
+    {
+        _CaptureDeltaBase(path, field, *previous);
+        mStats.RemoveValue(i->second.specType, field, *previous);
+    }
+
+    if (i->second.fields.Erase(field))
+    {
+        _MarkDirty(path);
     }
 }
 
 std::vector<TfToken>
 RenderStudioData::List(const SdfPath& path) const
 {
-    std::vector<TfToken> names;
     _HashTable::const_iterator i = mData.find(path);
     if (i != mData.end())
     {
-        const _SpecData& spec = i->second;
-
-        const size_t numFields = spec.fields.size();
-        names.resize(numFields);
-        for (size_t j = 0; j != numFields; ++j)
+        std::vector<TfToken> fields = i->second.fields.GetKeys();
+        if (i->second.timeSamples)
         {
-            names[j] = spec.fields[j].first;
+            fields.push_back(SdfDataTokens->TimeSamples);
         }
+        return fields;
     }
-    return names;
+
+    const SdfAbstractData* backing = _GetBackingData(path);
+    return backing ? backing->List(path) : std::vector<TfToken> {};
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -620,13 +2321,12 @@ RenderStudioData::List(const SdfPath& path) const
 std::set<double>
 RenderStudioData::ListAllTimeSamples() const
 {
-    // Use a set to determine unique times.
+    // Index is already sorted and unique, so it's inserted with hint in linear time
     std::set<double> times;
 
-    TF_FOR_ALL(i, mData)
+    for (const auto& [time, count] : mTimeIndex)
     {
-        std::set<double> timesForPath = ListTimeSamplesForPath(i->first);
-        times.insert(timesForPath.begin(), timesForPath.end());
+        times.insert(times.end(), time);
     }
 
     return times;
@@ -635,13 +2335,19 @@ RenderStudioData::ListAllTimeSamples() const
 std::set<double>
 RenderStudioData::ListTimeSamplesForPath(const SdfPath& path) const
 {
+    if (const SdfAbstractData* backing = _GetBackingData(path))
+    {
+        return backing->ListTimeSamplesForPath(path);
+    }
+
     std::set<double> times;
 
-    VtValue value = Get(path, SdfDataTokens->TimeSamples);
-    if (value.IsHolding<SdfTimeSampleMap>())
+    if (const RenderStudioTimeSamples* samples = _GetTimeSamples(path))
     {
-        const SdfTimeSampleMap& timeSampleMap = value.UncheckedGet<SdfTimeSampleMap>();
-        TF_FOR_ALL(j, timeSampleMap) { times.insert(j->first); }
+        for (double time : samples->GetTimes())
+        {
+            times.insert(times.end(), time);
+        }
     }
 
     return times;
@@ -691,83 +2397,81 @@ _GetBracketingTimeSamplesImpl(
 }
 
 static bool
-_GetBracketingTimeSamples(const std::set<double>& samples, double time, double* tLower, double* tUpper)
-{
-    return _GetBracketingTimeSamplesImpl(
-        samples, [](double t) { return t; }, time, tLower, tUpper);
-}
-
-static bool
-_GetBracketingTimeSamples(const SdfTimeSampleMap& samples, double time, double* tLower, double* tUpper)
+_GetBracketingTimeSamples(const std::map<double, std::size_t>& samples, double time, double* tLower, double* tUpper)
 {
     return _GetBracketingTimeSamplesImpl(
-        samples, [](SdfTimeSampleMap::value_type const& p) { return p.first; }, time, tLower, tUpper);
+        samples, [](std::map<double, std::size_t>::value_type const& p) { return p.first; }, time, tLower, tUpper);
 }
 
 bool
 RenderStudioData::GetBracketingTimeSamples(double time, double* tLower, double* tUpper) const
 {
-    return _GetBracketingTimeSamples(ListAllTimeSamples(), time, tLower, tUpper);
+    return _GetBracketingTimeSamples(mTimeIndex, time, tLower, tUpper);
 }
 
 size_t
 RenderStudioData::GetNumTimeSamplesForPath(const SdfPath& path) const
 {
-    if (const VtValue* fval = _GetFieldValue(path, SdfDataTokens->TimeSamples))
+    if (const SdfAbstractData* backing = _GetBackingData(path))
     {
-        if (fval->IsHolding<SdfTimeSampleMap>())
-        {
-            return fval->UncheckedGet<SdfTimeSampleMap>().size();
-        }
+        return backing->GetNumTimeSamplesForPath(path);
     }
-    return 0;
+
+    const RenderStudioTimeSamples* samples = _GetTimeSamples(path);
+    return samples ? samples->size() : 0;
 }
 
 bool
 RenderStudioData::GetBracketingTimeSamplesForPath(const SdfPath& path, double time, double* tLower, double* tUpper)
     const
 {
-    const VtValue* fval = _GetFieldValue(path, SdfDataTokens->TimeSamples);
-    if (fval && fval->IsHolding<SdfTimeSampleMap>())
+    if (const SdfAbstractData* backing = _GetBackingData(path))
     {
-        auto const& tsmap = fval->UncheckedGet<SdfTimeSampleMap>();
-        return _GetBracketingTimeSamples(tsmap, time, tLower, tUpper);
+        return backing->GetBracketingTimeSamplesForPath(path, time, tLower, tUpper);
     }
-    return false;
+
+    const RenderStudioTimeSamples* samples = _GetTimeSamples(path);
+    return samples && samples->GetBracketingTimes(time, tLower, tUpper);
 }
 
 bool
 RenderStudioData::QueryTimeSample(const SdfPath& path, double time, VtValue* value) const
 {
-    const VtValue* fval = _GetFieldValue(path, SdfDataTokens->TimeSamples);
-    if (fval && fval->IsHolding<SdfTimeSampleMap>())
+    if (const SdfAbstractData* backing = _GetBackingData(path))
     {
-        auto const& tsmap = fval->UncheckedGet<SdfTimeSampleMap>();
-        auto iter = tsmap.find(time);
-        if (iter != tsmap.end())
-        {
-            if (value)
-                *value = iter->second;
-            return true;
-        }
+        return backing->QueryTimeSample(path, time, value);
     }
-    return false;
+
+    const RenderStudioTimeSamples* samples = _GetTimeSamples(path);
+    const VtValue* sample = samples ? samples->Find(time) : nullptr;
+    if (sample == nullptr)
+    {
+        return false;
+    }
+
+    if (value)
+    {
+        *value = *sample;
+    }
+    return true;
 }
 
 bool
 RenderStudioData::QueryTimeSample(const SdfPath& path, double time, SdfAbstractDataValue* value) const
 {
-    const VtValue* fval = _GetFieldValue(path, SdfDataTokens->TimeSamples);
-    if (fval && fval->IsHolding<SdfTimeSampleMap>())
+    if (const SdfAbstractData* backing = _GetBackingData(path))
     {
-        auto const& tsmap = fval->UncheckedGet<SdfTimeSampleMap>();
-        auto iter = tsmap.find(time);
-        if (iter != tsmap.end())
-        {
-            return !value || value->StoreValue(iter->second);
-        }
+        return backing->QueryTimeSample(path, time, value);
     }
-    return false;
+
+    const RenderStudioTimeSamples* samples = _GetTimeSamples(path);
+    const VtValue* sample = samples ? samples->Find(time) : nullptr;
+    if (sample == nullptr)
+    {
+        return false;
+    }
+
+    return !value || value->StoreValue(*sample);
 }
 
 void
@@ -779,61 +2483,63 @@ RenderStudioData::SetTimeSample(const SdfPath& path, double time, const VtValue&
         return;
     }
 
-    SdfTimeSampleMap newSamples;
+    // Existing samples are edited in place
+    _HashTable::iterator i = _MaterializeSpec(path);
+    if (i != mData.end() && i->second.timeSamples)
+    {
+        if (const VtValue* previous = i->second.timeSamples->Find(time))
+        {
+            mStats.RemoveValue(i->second.specType, SdfDataTokens->TimeSamples, *previous);
+        }
 
-    // Attempt to get a pointer to an existing timeSamples field.
-    VtValue* fieldValue = _GetMutableFieldValue(path, SdfDataTokens->TimeSamples);
+        if (i->second.timeSamples->Set(time, value))
+        {
+            _AddTime(time);
+        }
 
-    // If we have one, swap it out so we can modify it.
-    if (fieldValue && fieldValue->IsHolding<SdfTimeSampleMap>())
-    {
-        fieldValue->UncheckedSwap(newSamples);
+        mStats.AddValue(i->second.specType, SdfDataTokens->TimeSamples, value);
+
+        _MarkDirty(path);
+        _RecordTimeSampleDelta(path, time, value);
+        return;
     }
 
-    // Insert or overwrite into newSamples.
+    SdfTimeSampleMap newSamples;
     newSamples[time] = value;
-
-    // Set back into the field.
-    if (fieldValue)
-    {
-        fieldValue->Swap(newSamples);
-    }
-    else
-    {
-        Set(path, SdfDataTokens->TimeSamples, VtValue::Take(newSamples));
-    }
+    Set(path, SdfDataTokens->TimeSamples, VtValue::Take(newSamples));
 }
 
 void
 RenderStudioData::EraseTimeSample(const SdfPath& path, double time)
 {
-    SdfTimeSampleMap newSamples;
-
-    // Attempt to get a pointer to an existing timeSamples field.
-    VtValue* fieldValue = _GetMutableFieldValue(path, SdfDataTokens->TimeSamples);
-
-    // If we have one, swap it out so we can modify it.  If we do not have one,
-    // there's nothing to erase so we're done.
-    if (fieldValue && fieldValue->IsHolding<SdfTimeSampleMap>())
+    // Don't materialize backing spec if there's nothing to erase
+    const SdfAbstractData* backing = _GetBackingData(path);
+    if (backing && !backing->QueryTimeSample(path, time, static_cast<VtValue*>(nullptr)))
     {
-        fieldValue->UncheckedSwap(newSamples);
+        return;
     }
-    else
+
+    _HashTable::iterator i = _MaterializeSpec(path);
+    const VtValue* previous = i != mData.end() && i->second.timeSamples ? i->second.timeSamples->Find(time) : nullptr;
+    if (previous == nullptr)
     {
         return;
     }
 
-    // Erase from newSamples.
-    newSamples.erase(time);
+    mStats.RemoveValue(i->second.specType, SdfDataTokens->TimeSamples, *previous);
+    i->second.timeSamples->Erase(time);
+
+    _RemoveTime(time);
+    _RecordTimeSampleDelta(path, time, VtValue());
 
     // Check to see if the result is empty.  In that case we remove the field.
-    if (newSamples.empty())
+    if (i->second.timeSamples->empty())
     {
         Erase(path, SdfDataTokens->TimeSamples);
     }
     else
     {
-        fieldValue->UncheckedSwap(newSamples);
+        _MarkDirty(path);
     }
 }
 
@@ -843,4 +2549,11 @@ RenderStudioData::SetOriginalFormat(SdfFileFormatConstPtr format)
     mOriginalFormat = format;
 }
 
+void
+RenderStudioData::SetLayerRegistry(RenderStudioLayerRegistry* registry, const std::string& identifier)
+{
+    mLayerRegistry = registry;
+    mIdentifier = identifier;
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -15,8 +15,19 @@
 #pragma once
 
 #pragma warning(push, 0)
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <unordered_map>
+
 #include <pxr/base/tf/declarePtrs.h>
+#include <pxr/base/tf/hash.h>
 #include <pxr/base/tf/hashmap.h>
+#include <pxr/base/tf/hashset.h>
 #include <pxr/base/tf/token.h>
 #include <pxr/base/vt/value.h>
 #include <pxr/pxr.h>
@@ -27,6 +38,12 @@
 #include <pxr/usd/usd/stage.h>
 #pragma warning(pop)
 
+#include "FieldMap.h"
+#include "FlatHashMap.h"
+#include "Snapshot.h"
+#include "Stats.h"
+#include "TimeSamples.h"
+
 #include <Notice/Notice.h>
 #include <Serialization/Api.h>
 
@@ -35,6 +52,7 @@ PXR_NAMESPACE_OPEN_SCOPE
 TF_DECLARE_WEAK_AND_REF_PTRS(RenderStudioData);
 
 class RenderStudioFileFormat;
+class RenderStudioLayerRegistry;
 
 class RenderStudioData : public SdfAbstractData
 {
@@ -110,12 +128,80 @@ public:
     AR_API
     virtual void EraseTimeSample(const SdfPath& path, double time);
 
+    /// Namespace operations over whole subtree, remote namespace edits are applied through them.
+    /// With hierarchy index enabled they cost O(subtree), otherwise whole spec table is scanned.
+    /// Values are moved, only subtree root is relinked in the index.
+    AR_API
+    void EraseSubtree(const SdfPath& path);
+
+    AR_API
+    void MoveSubtree(const SdfPath& oldPath, const SdfPath& newPath);
+
+    AR_API
+    std::vector<SdfPath> ListChildren(const SdfPath& path) const;
+
+    /// Takes over specs of freshly read layer data. Source is drained spec by spec and left empty.
+    AR_API
+    void AdoptFrom(const SdfAbstractDataPtr& source);
+
+    /// Streaming mode. Specs are read straight from backing (memory mapped crate) data until they are written,
+    /// only then they're copied into own table. Returns false if streaming can't be used for this data.
+    AR_API
+    bool AttachBackingData(const SdfAbstractDataRefPtr& backing, const std::string& path);
+
+    /// Copies all untouched specs from backing data and releases it
+    AR_API
+    void DetachBackingData();
+
+    AR_API
+    const std::string& GetBackingPath() const { return mBackingPath; }
+
     AR_API
     std::size_t GetSequence() const { return mLatestAppliedSequence; }
 
+    /// Returns latest published snapshot of the layer data, could be called from any thread.
+    /// Snapshots are published once per live update, if enabled with RENDER_STUDIO_DATA_SNAPSHOTS.
+    AR_API
+    std::shared_ptr<const RenderStudioDataSnapshot> GetSnapshot() const;
+
+    /// Estimated memory held by own spec table, specs still in backing data aren't counted.
+    /// Must be called from USD thread, counters are updated along with the table.
+    AR_API
+    const RenderStudioDataStats& GetStats() const { return mStats; }
+
+    /// Local deltas waiting for next send
+    AR_API
+    std::size_t GetLocalDeltaCount() const { return mLocalDeltas.size(); }
+
+    AR_API
+    bool HasLocalDeltas() const
+    {
+        return !mLocalDeltas.empty() || !mLocalNamespaceEdits.empty() || !mPendingFullResends.empty();
+    }
+
+    /// Incremented on every recorded local edit, unchanged value means user stopped editing
+    AR_API
+    std::size_t GetLocalRevision() const { return mLocalRevision; }
+
+    /// Remote updates waiting for earlier sequences, could be called from any thread
+    AR_API
+    std::size_t GetRemoteQueueSize() const;
+
+    /// Subtree erases and moves applied at once, rather than spec by spec
+    AR_API
+    std::size_t GetSubtreeEditCount() const { return mSubtreeEditCount; }
+
+    /// Paths with own sent edits which server didn't acknowledge yet
+    AR_API
+    std::size_t GetUnacknowledgedCount() const { return mUnacknowledgedFields.size(); }
+
     AR_API
     void SetOriginalFormat(SdfFileFormatConstPtr format);
 
+    /// Local edits mark the layer dirty in registry, so next live update sends them
+    AR_API
+    void SetLayerRegistry(RenderStudioLayerRegistry* registry, const std::string& identifier);
+
     AR_API
     SdfFileFormatConstPtr GetOriginalFormat() const { return mOriginalFormat; };
 
@@ -126,7 +212,6 @@ protected:
 
 private:
     // Backing storage for a single "spec" -- prim, property, etc.
-    typedef std::pair<TfToken, VtValue> _FieldValuePair;
     struct _SpecData
     {
         _SpecData()
@@ -135,49 +220,215 @@ private:
         }
 
         SdfSpecType specType;
-        std::vector<_FieldValuePair> fields;
+
+        // Position inside parent's children list, used only with hierarchy index
+        std::uint32_t childIndex = 0;
+
+        RenderStudioFieldMap fields;
+
+        // Kept apart from fields, so samples are edited in place. Exposed as SdfTimeSampleMap field
+        std::unique_ptr<RenderStudioTimeSamples> timeSamples;
     };
 
-    // Hashtable storing _SpecData.
+    // Flat hashtable storing _SpecData.
     typedef SdfPath _Key;
     typedef SdfPath::Hash _KeyHash;
-    typedef TfHashMap<_Key, _SpecData, _KeyHash> _HashTable;
+    typedef RenderStudioFlatHashMap<_Key, _SpecData, _KeyHash> _HashTable;
+
+    // Deltas are kept in the same move only layout as they travel through the network
+    typedef RenderStudio::API::DeltaTable _DeltaTable;
+
+    // Parent path to direct children. Parent itself isn't required to have a spec
+    typedef RenderStudioFlatHashMap<_Key, std::vector<SdfPath>, _KeyHash> _ChildrenTable;
+
+    // Single remote message, namespace edits are applied before deltas.
+    // Messages collapsed while host wasn't updating cover range of sequences up to lastSequence
+    struct _RemoteUpdate
+    {
+        _DeltaTable deltas;
+        std::vector<RenderStudio::API::NamespaceEdit> namespaceEdits;
+        std::size_t lastSequence = 0;
+    };
+
+    // Notices gathered during single remote update, allocated from frame arena
+    typedef std::pmr::vector<RenderStudioNotice::PrimitiveChanged> _NoticeList;
+
+    // Newest full write of a field among queued updates, and latest update with namespace edits before it.
+    // Older writes and ops of the field since that namespace edit are overwritten anyway and aren't applied.
+    struct _FieldWrite
+    {
+        std::size_t sequence = 0;
+        std::size_t barrier = 0;
+    };
+
+    typedef std::pmr::unordered_map<std::pair<SdfPath, TfToken>, _FieldWrite, TfHash> _FieldWrites;
 
 private:
     void ApplyDelta(
         SdfLayerHandle& layer,
-        std::vector<RenderStudioNotice::PrimitiveChanged>& notices,
+        _NoticeList& notices,
         const SdfPath& path,
         const TfToken& key,
         const VtValue& value,
         SdfSpecType spec);
-    void ProcessRemoteUpdates(SdfLayerHandle& layer);
-    void AccumulateRemoteUpdate(const _HashTable& deltas, std::size_t sequence);
-    _HashTable FetchLocalDeltas();
+    void ApplyTimeSampleDelta(
+        SdfLayerHandle& layer,
+        const SdfPath& path,
+        const RenderStudio::API::TimeSampleOp& op,
+        SdfSpecType spec);
+    void ApplyArrayDiff(
+        SdfLayerHandle& layer,
+        const SdfPath& path,
+        const TfToken& key,
+        const RenderStudio::API::ArrayDiff& diff);
+    void ApplyChildrenOps(
+        SdfLayerHandle& layer,
+        const SdfPath& path,
+        const TfToken& field,
+        const std::vector<RenderStudio::API::ChildrenOp>& ops,
+        SdfSpecType spec);
+    void ApplyDictionaryOp(
+        SdfLayerHandle& layer,
+        const SdfPath& path,
+        const RenderStudio::API::DictionaryOp& op,
+        SdfSpecType spec);
+    void ApplyListOpEdit(
+        SdfLayerHandle& layer,
+        const SdfPath& path,
+        const RenderStudio::API::ListOpEdit& edit,
+        SdfSpecType spec);
+    void ApplyNamespaceEdit(
+        SdfLayerHandle& layer,
+        _NoticeList& notices,
+        const RenderStudio::API::NamespaceEdit& edit);
+    bool ProcessRemoteUpdates(
+        SdfLayerHandle& layer,
+        std::pmr::memory_resource* arena,
+        std::chrono::steady_clock::time_point deadline);
+    void SendNotices(const _NoticeList& notices, std::pmr::memory_resource* arena);
+    _FieldWrites CollectNewestWrites(std::pmr::memory_resource* arena) const;
+    static bool IsSuperseded(
+        const _FieldWrites& writes,
+        const SdfPath& path,
+        const TfToken& field,
+        std::size_t sequence);
+    void AccumulateRemoteUpdate(
+        _DeltaTable&& deltas,
+        std::vector<RenderStudio::API::NamespaceEdit>&& namespaceEdits,
+        std::size_t sequence,
+        std::size_t lastSequence);
+    _DeltaTable FetchLocalDeltas(bool includeInteractive);
+    _DeltaTable CollectEphemeralDeltas();
+    _DeltaTable CollectJournalDeltas() const;
+    void RestoreJournalDeltas(SdfLayerHandle& layer, const RenderStudio::API::DeltaEvent& journal);
+    void AccumulateEphemeralUpdate(_DeltaTable&& deltas);
+    std::vector<RenderStudio::API::NamespaceEdit> FetchLocalNamespaceEdits();
+    const std::vector<RenderStudio::API::NamespaceEdit>& GetLocalNamespaceEdits() const { return mLocalNamespaceEdits; }
     void OnLoaded();
 
     const VtValue* _GetSpecTypeAndFieldValue(const SdfPath& path, const TfToken& field, SdfSpecType* specType) const;
 
     const VtValue* _GetFieldValue(const SdfPath& path, const TfToken& field) const;
 
-    VtValue* _GetMutableFieldValue(const SdfPath& path, const TfToken& field);
+    VtValue* _GetOrCreateFieldValue(const SdfPath& path, const TfToken& field, SdfSpecType* specType);
 
-    VtValue* _GetOrCreateFieldValue(const SdfPath& path, const TfToken& field);
+    RenderStudio::API::SpecData* _GetOrCreateSpecDelta(const SdfPath& path);
 
     VtValue* _GetOrCreateFieldValueDelta(const SdfPath& path, const TfToken& field);
 
+    void _RecordTimeSampleDelta(const SdfPath& path, double time, const VtValue& value);
+
+    void _CaptureDeltaBase(const SdfPath& path, const TfToken& field, const VtValue& previous);
+    void _CompactLocalDeltas();
+    void _RequestFullResend(const SdfPath& path, const TfToken& field);
+
+    void _RecordNamespaceEdit(const RenderStudio::API::NamespaceEdit& edit);
+    void _MarkLayerDirty();
+    bool _IsUnderUnacknowledgedNamespaceEdit(const SdfPath& path) const;
+
+    _HashTable::iterator _MaterializeSpec(const SdfPath& path);
+    const SdfAbstractData* _GetBackingData(const SdfPath& path) const;
+    void _ForEachBackingSpec(const std::function<bool(const SdfPath&)>& fn) const;
+
+    void _LinkChild(const SdfPath& path, _SpecData& spec);
+    void _UnlinkChild(const SdfPath& path, const _SpecData& spec);
+    void _CollectSubtree(const SdfPath& path, std::vector<SdfPath>& result) const;
+    bool _DropSpec(const SdfPath& path);
+
+    void _AddTime(double time);
+    void _RemoveTime(double time);
+    void _IndexTimeSamples(const RenderStudioTimeSamples& samples, bool add);
+
+    void _AccountFields(const _SpecData& spec, bool add);
+    void _AccountTimeSamples(const _SpecData& spec, bool add);
+
+    void _AdoptTimeSamples(_SpecData& spec);
+    const RenderStudioTimeSamples* _GetTimeSamples(const SdfPath& path) const;
+    void _SetTimeSamples(const SdfPath& path, const SdfTimeSampleMap& samples);
+
+    void _MarkDirty(const SdfPath& path);
+    void _PublishSnapshot();
+
 private:
     friend class RenderStudioFileFormat;
 
     _HashTable mData;
-    _HashTable mLocalDeltas;
+    _DeltaTable mLocalDeltas;
+    std::size_t mLocalRevision = 0;
+
+    // Revision of latest edit of each pending delta, interactive ones edited after last relay are relayed again
+    TfHashMap<SdfPath, std::size_t, SdfPath::Hash> mLocalDeltaRevisions;
+    std::size_t mEphemeralRevision = 0;
+    RenderStudioDataStats mStats;
+
+    _ChildrenTable mChildren;
+    bool mHierarchyIndexEnabled = false;
+
+    // Every sample time in layer with number of attributes which have sample at it
+    std::map<double, std::size_t> mTimeIndex;
+
+    // Specs which aren't in mData are read from backing data, unless they were detached (erased or materialized)
+    SdfAbstractDataRefPtr mBackingData;
+    std::string mBackingPath;
+    TfHashSet<SdfPath, SdfPath::Hash> mDetachedBackingSpecs;
+
+    // Paths changed since last published snapshot
+    TfHashSet<SdfPath, SdfPath::Hash> mSnapshotDirtyPaths;
+    std::shared_ptr<const RenderStudioDataSnapshot> mSnapshot;
+    mutable std::mutex mSnapshotMutex;
+    bool mSnapshotsEnabled = false;
 
     SdfFileFormatConstPtr mOriginalFormat = nullptr;
 
+    RenderStudioLayerRegistry* mLayerRegistry = nullptr;
+    std::string mIdentifier;
+
     std::set<SdfPath> mUnacknowledgedFields;
-    std::mutex mRemoteMutex;
+
+    // Array values as they were before first local edit since last send, diffs are made against them
+    std::map<std::pair<SdfPath, TfToken>, VtValue> mLocalDeltaBases;
+    std::set<std::pair<SdfPath, TfToken>> mPendingFullResends;
+
+    // Children inserted or moved by own sent ops until server acknowledges them, see RenderStudioChildrenDiff::Apply
+    std::map<std::pair<SdfPath, TfToken>, TfHashSet<TfToken, TfToken::HashFunctor>> mPendingLocalChildren;
+
+    // Dictionary keys edited by own sent ops until server acknowledges them
+    std::map<std::pair<SdfPath, TfToken>, std::set<std::string>> mPendingLocalKeys;
+
+    // Subtree erases and moves since last send, and roots of sent ones until server acknowledges them
+    std::vector<RenderStudio::API::NamespaceEdit> mLocalNamespaceEdits;
+    std::set<SdfPath> mUnacknowledgedNamespaceEdits;
+
+    // Remote edit which layer is applying through EraseSpec or MoveSpec calls
+    const RenderStudio::API::NamespaceEdit* mRemoteNamespaceEdit = nullptr;
+    std::size_t mSubtreeEditCount = 0;
+
+    mutable std::mutex mRemoteMutex;
     std::size_t mLatestAppliedSequence = 0;
-    std::map<std::size_t, _HashTable> mRemoteDeltasQueue;
+    std::map<std::size_t, _RemoteUpdate> mRemoteDeltasQueue;
+
+    // Latest interactive values of other users, applied before sequenced updates
+    _DeltaTable mRemoteEphemeral;
     bool mIsLoaded = false;
     bool mIsProcessingRemoteUpdates = false;
 };
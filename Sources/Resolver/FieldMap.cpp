@@ -0,0 +1,175 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "FieldMap.h"
+
+#pragma warning(push, 0)
+#include <algorithm>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+const std::vector<TfToken>&
+RenderStudioFieldMap::GetKeys() const
+{
+    static const std::vector<TfToken> kEmpty;
+    return mStorage ? mStorage->keys : kEmpty;
+}
+
+const VtValue*
+RenderStudioFieldMap::Find(const TfToken& field) const
+{
+    std::size_t position = _FindPosition(field);
+    return position != npos ? &mStorage->values[position] : nullptr;
+}
+
+VtValue&
+RenderStudioFieldMap::FindOrCreate(const TfToken& field)
+{
+    std::size_t position = _FindPosition(field);
+    _Storage& storage = _GetMutableStorage();
+
+    if (position != npos)
+    {
+        return storage.values[position];
+    }
+
+    storage.keys.push_back(field);
+    storage.values.emplace_back();
+
+    if (storage.keys.size() > kIndexThreshold)
+    {
+        if (storage.index.empty())
+        {
+            _RebuildIndex(storage);
+        }
+        else
+        {
+            _IndexEntry entry { TfToken::HashFunctor {}(field), static_cast<std::uint32_t>(storage.keys.size() - 1) };
+            auto it = std::lower_bound(
+                storage.index.begin(),
+                storage.index.end(),
+                entry.hash,
+                [](const _IndexEntry& item, std::size_t hash) { return item.hash < hash; });
+            storage.index.insert(it, entry);
+        }
+    }
+
+    return storage.values.back();
+}
+
+bool
+RenderStudioFieldMap::Erase(const TfToken& field)
+{
+    std::size_t position = _FindPosition(field);
+
+    if (position == npos)
+    {
+        return false;
+    }
+
+    _Storage& storage = _GetMutableStorage();
+    storage.keys.erase(storage.keys.begin() + position);
+    storage.values.erase(storage.values.begin() + position);
+
+    // Positions after erased one are shifted, it's rare enough to just rebuild
+    storage.index.clear();
+    if (storage.keys.size() > kIndexThreshold)
+    {
+        _RebuildIndex(storage);
+    }
+
+    return true;
+}
+
+void
+RenderStudioFieldMap::Clear()
+{
+    // Other copies keep their storage
+    mStorage.reset();
+}
+
+std::size_t
+RenderStudioFieldMap::_FindPosition(const TfToken& field) const
+{
+    if (mStorage == nullptr)
+    {
+        return npos;
+    }
+
+    const _Storage& storage = *mStorage;
+
+    if (storage.index.empty())
+    {
+        for (std::size_t i = 0; i < storage.keys.size(); i++)
+        {
+            if (storage.keys[i] == field)
+            {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    std::size_t hash = TfToken::HashFunctor {}(field);
+    auto it = std::lower_bound(
+        storage.index.begin(),
+        storage.index.end(),
+        hash,
+        [](const _IndexEntry& item, std::size_t h) { return item.hash < h; });
+
+    for (; it != storage.index.end() && it->hash == hash; ++it)
+    {
+        if (storage.keys[it->position] == field)
+        {
+            return it->position;
+        }
+    }
+
+    return npos;
+}
+
+RenderStudioFieldMap::_Storage&
+RenderStudioFieldMap::_GetMutableStorage()
+{
+    if (mStorage == nullptr)
+    {
+        mStorage = std::make_shared<_Storage>();
+    }
+    else if (mStorage.use_count() > 1)
+    {
+        // Shared with snapshot or another copy. Copies are made only from holders, so count of 1 can't grow
+        mStorage = std::make_shared<_Storage>(*mStorage);
+    }
+
+    return *mStorage;
+}
+
+void
+RenderStudioFieldMap::_RebuildIndex(_Storage& storage)
+{
+    storage.index.resize(storage.keys.size());
+
+    for (std::size_t i = 0; i < storage.keys.size(); i++)
+    {
+        storage.index[i] = _IndexEntry { TfToken::HashFunctor {}(storage.keys[i]), static_cast<std::uint32_t>(i) };
+    }
+
+    std::sort(
+        storage.index.begin(),
+        storage.index.end(),
+        [](const _IndexEntry& a, const _IndexEntry& b) { return a.hash < b.hash; });
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,77 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Compact storage for the fields of a single spec.
+/// Keys and values are kept in separate arrays, so a lookup scans a dense array of token pointers only.
+/// Specs with many fields additionally keep an index sorted by token hash and use binary search.
+/// Insertion order is preserved, as in SdfData.
+/// Copies share storage until one of them is modified, so snapshots can hold spec fields without copying values.
+class RenderStudioFieldMap
+{
+public:
+    std::size_t size() const { return mStorage ? mStorage->keys.size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    const TfToken& GetKey(std::size_t i) const { return mStorage->keys[i]; }
+    const VtValue& GetValue(std::size_t i) const { return mStorage->values[i]; }
+    const std::vector<TfToken>& GetKeys() const;
+
+    const VtValue* Find(const TfToken& field) const;
+
+    /// Mutable access, detaches storage from other copies first
+    VtValue& FindOrCreate(const TfToken& field);
+    bool Erase(const TfToken& field);
+    void Clear();
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // Linear scan over 8 byte keys beats binary search up to this size
+    static constexpr std::size_t kIndexThreshold = 16;
+
+    struct _IndexEntry
+    {
+        std::size_t hash;
+        std::uint32_t position;
+    };
+
+    struct _Storage
+    {
+        std::vector<TfToken> keys;
+        std::vector<VtValue> values;
+        std::vector<_IndexEntry> index;
+    };
+
+    std::size_t _FindPosition(const TfToken& field) const;
+    _Storage& _GetMutableStorage();
+    static void _RebuildIndex(_Storage& storage);
+
+    std::shared_ptr<_Storage> mStorage;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
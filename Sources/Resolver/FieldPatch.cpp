@@ -0,0 +1,293 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "FieldPatch.h"
+
+#pragma warning(push, 0)
+#include <algorithm>
+
+#include <pxr/base/vt/dictionary.h>
+#include <pxr/usd/sdf/listOp.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/reference.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace
+{
+
+using DictionaryOp = RenderStudio::API::DictionaryOp;
+using ListOpEdit = RenderStudio::API::ListOpEdit;
+
+// Ops are sent only if there are at most half as many of them as keys or items
+constexpr std::size_t kMaxOpsFraction = 2;
+
+template <class T> struct _ListOpItems
+{
+    using Items = typename SdfListOp<T>::ItemVector;
+
+    Items prepended;
+    Items appended;
+    Items deleted;
+
+    explicit _ListOpItems(const SdfListOp<T>& listOp)
+        : prepended(listOp.GetPrependedItems())
+        , appended(listOp.GetAppendedItems())
+        , deleted(listOp.GetDeletedItems())
+    {
+    }
+
+    std::size_t size() const { return prepended.size() + appended.size() + deleted.size(); }
+
+    bool Contains(const T& item) const
+    {
+        return std::find(prepended.begin(), prepended.end(), item) != prepended.end()
+            || std::find(appended.begin(), appended.end(), item) != appended.end()
+            || std::find(deleted.begin(), deleted.end(), item) != deleted.end();
+    }
+
+    void Apply(ListOpEdit::Type type, const T& item)
+    {
+        for (Items* items : { &prepended, &appended, &deleted })
+        {
+            items->erase(std::remove(items->begin(), items->end(), item), items->end());
+        }
+
+        switch (type)
+        {
+        case ListOpEdit::Type::Prepend:
+            prepended.insert(prepended.begin(), item);
+            break;
+        case ListOpEdit::Type::Append:
+            appended.push_back(item);
+            break;
+        case ListOpEdit::Type::Delete:
+            deleted.push_back(item);
+            break;
+        case ListOpEdit::Type::Remove:
+            break;
+        }
+    }
+
+    bool operator==(const _ListOpItems& other) const
+    {
+        return prepended == other.prepended && appended == other.appended && deleted == other.deleted;
+    }
+};
+
+template <class T>
+bool
+_IsPatchable(const SdfListOp<T>& listOp)
+{
+    // Added and ordered items are deprecated and aren't serialized at all
+    return !listOp.IsExplicit() && listOp.GetAddedItems().empty() && listOp.GetOrderedItems().empty();
+}
+
+template <class T>
+std::optional<std::vector<ListOpEdit>>
+_ComputeListOp(const TfToken& field, const SdfListOp<T>& baseListOp, const SdfListOp<T>& valueListOp)
+{
+    using Items = typename _ListOpItems<T>::Items;
+
+    if (!_IsPatchable(baseListOp) || !_IsPatchable(valueListOp))
+    {
+        return std::nullopt;
+    }
+
+    _ListOpItems<T> working(baseListOp);
+    const _ListOpItems<T> target(valueListOp);
+    const std::size_t limit = std::max(working.size(), target.size()) / kMaxOpsFraction;
+
+    std::vector<ListOpEdit> ops;
+    auto emit = [&](ListOpEdit::Type type, const T& item)
+    {
+        ops.push_back(ListOpEdit { field, type, VtValue { item } });
+        working.Apply(type, item);
+    };
+
+    // Items which belong to other list now are moved out by the ops of that list, so they're ignored here
+    auto keptItems = [](const Items& items, const Items& goal)
+    {
+        Items kept;
+        std::copy_if(
+            items.begin(),
+            items.end(),
+            std::back_inserter(kept),
+            [&goal](const T& item) { return std::find(goal.begin(), goal.end(), item) != goal.end(); });
+        return kept;
+    };
+
+    for (const Items* items : { &working.prepended, &working.appended, &working.deleted })
+    {
+        for (const T& item : Items(*items))
+        {
+            if (!target.Contains(item))
+            {
+                emit(ListOpEdit::Type::Remove, item);
+            }
+        }
+    }
+
+    // Appended and deleted items are added to the back, so reuse existing head of the list if it's in place
+    for (auto [type, goal] : { std::make_pair(ListOpEdit::Type::Append, &target.appended),
+                               std::make_pair(ListOpEdit::Type::Delete, &target.deleted) })
+    {
+        const Items& current = type == ListOpEdit::Type::Append ? working.appended : working.deleted;
+        Items kept = keptItems(current, *goal);
+        std::size_t start = std::equal(kept.begin(), kept.end(), goal->begin(), goal->begin() + kept.size())
+            ? kept.size()
+            : 0;
+
+        for (std::size_t i = start; i < goal->size(); i++)
+        {
+            emit(type, (*goal)[i]);
+        }
+    }
+
+    // Prepended items are added to the front, so reuse existing tail
+    Items kept = keptItems(working.prepended, target.prepended);
+    std::size_t count = target.prepended.size();
+    if (std::equal(kept.rbegin(), kept.rend(), target.prepended.rbegin(), target.prepended.rbegin() + kept.size()))
+    {
+        count -= kept.size();
+    }
+
+    for (std::size_t i = count; i > 0; i--)
+    {
+        emit(ListOpEdit::Type::Prepend, target.prepended[i - 1]);
+    }
+
+    if (ops.size() > limit || !(working == target))
+    {
+        return std::nullopt;
+    }
+
+    return ops;
+}
+
+template <class T>
+bool
+_ApplyListOp(const VtValue& current, const ListOpEdit& edit, VtValue* result)
+{
+    if (!edit.item.IsHolding<T>() || !(current.IsEmpty() || current.IsHolding<SdfListOp<T>>()))
+    {
+        return false;
+    }
+
+    const SdfListOp<T> listOp = current.GetWithDefault<SdfListOp<T>>();
+    if (listOp.IsExplicit())
+    {
+        return false;
+    }
+
+    _ListOpItems<T> items(listOp);
+    items.Apply(edit.type, edit.item.UncheckedGet<T>());
+    *result = VtValue { SdfListOp<T>::Create(items.prepended, items.appended, items.deleted) };
+    return true;
+}
+
+} // namespace
+
+bool
+RenderStudioFieldPatch::IsSupported(const VtValue& value)
+{
+    return value.IsHolding<VtDictionary>() || value.IsHolding<SdfPathListOp>()
+        || value.IsHolding<SdfReferenceListOp>() || value.IsHolding<SdfTokenListOp>();
+}
+
+std::optional<std::vector<DictionaryOp>>
+RenderStudioFieldPatch::ComputeDictionary(const TfToken& field, const VtValue& base, const VtValue& value)
+{
+    if (!base.IsHolding<VtDictionary>() || !value.IsHolding<VtDictionary>())
+    {
+        return std::nullopt;
+    }
+
+    const VtDictionary& baseDictionary = base.UncheckedGet<VtDictionary>();
+    const VtDictionary& valueDictionary = value.UncheckedGet<VtDictionary>();
+    const std::size_t limit = std::max(baseDictionary.size(), valueDictionary.size()) / kMaxOpsFraction;
+
+    std::vector<DictionaryOp> ops;
+
+    for (const auto& [key, item] : valueDictionary)
+    {
+        auto it = baseDictionary.find(key);
+        if (it == baseDictionary.end() || it->second != item)
+        {
+            ops.push_back(DictionaryOp { field, key, item });
+        }
+    }
+
+    for (const auto& [key, item] : baseDictionary)
+    {
+        if (valueDictionary.count(key) == 0)
+        {
+            ops.push_back(DictionaryOp { field, key, VtValue() });
+        }
+    }
+
+    if (ops.size() > limit)
+    {
+        return std::nullopt;
+    }
+
+    return ops;
+}
+
+std::optional<std::vector<ListOpEdit>>
+RenderStudioFieldPatch::ComputeListOp(const TfToken& field, const VtValue& base, const VtValue& value)
+{
+    if (base.IsHolding<SdfPathListOp>() && value.IsHolding<SdfPathListOp>())
+    {
+        return _ComputeListOp(field, base.UncheckedGet<SdfPathListOp>(), value.UncheckedGet<SdfPathListOp>());
+    }
+    else if (base.IsHolding<SdfReferenceListOp>() && value.IsHolding<SdfReferenceListOp>())
+    {
+        return _ComputeListOp(
+            field, base.UncheckedGet<SdfReferenceListOp>(), value.UncheckedGet<SdfReferenceListOp>());
+    }
+    else if (base.IsHolding<SdfTokenListOp>() && value.IsHolding<SdfTokenListOp>())
+    {
+        return _ComputeListOp(field, base.UncheckedGet<SdfTokenListOp>(), value.UncheckedGet<SdfTokenListOp>());
+    }
+
+    return std::nullopt;
+}
+
+VtValue
+RenderStudioFieldPatch::ApplyDictionary(const VtValue& current, const DictionaryOp& op)
+{
+    VtDictionary dictionary = current.GetWithDefault<VtDictionary>();
+
+    if (op.value.IsEmpty())
+    {
+        dictionary.erase(op.key);
+    }
+    else
+    {
+        dictionary[op.key] = op.value;
+    }
+
+    return VtValue { dictionary };
+}
+
+bool
+RenderStudioFieldPatch::ApplyListOp(const VtValue& current, const ListOpEdit& edit, VtValue* result)
+{
+    return _ApplyListOp<SdfPath>(current, edit, result) || _ApplyListOp<SdfReference>(current, edit, result)
+        || _ApplyListOp<TfToken>(current, edit, result);
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
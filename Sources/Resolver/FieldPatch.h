@@ -0,0 +1,56 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <optional>
+#include <vector>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#pragma warning(pop)
+
+#include <Serialization/Api.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Key level edits of VtDictionary fields (customData with ownership locks) and item level edits of SdfListOp
+/// fields, so small change of heavily annotated prim doesn't resend the whole value.
+class RenderStudioFieldPatch
+{
+public:
+    /// True for dictionaries and list ops of SdfPath, SdfReference and TfToken
+    static bool IsSupported(const VtValue& value);
+
+    /// Both return nothing if values can't be patched or so much was changed that full value is cheaper
+    static std::optional<std::vector<RenderStudio::API::DictionaryOp>> ComputeDictionary(
+        const TfToken& field,
+        const VtValue& base,
+        const VtValue& value);
+
+    static std::optional<std::vector<RenderStudio::API::ListOpEdit>> ComputeListOp(
+        const TfToken& field,
+        const VtValue& base,
+        const VtValue& value);
+
+    /// Empty current value is patched as empty dictionary or list op
+    static VtValue ApplyDictionary(const VtValue& current, const RenderStudio::API::DictionaryOp& op);
+
+    /// Returns false if current value isn't a list op of edited item type or is explicit list op
+    static bool ApplyListOp(const VtValue& current, const RenderStudio::API::ListOpEdit& edit, VtValue* result);
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -15,8 +15,12 @@
 #include "FileFormat.h"
 
 #pragma warning(push, 0)
+#include <algorithm>
 #include <filesystem>
+#include <iterator>
 
+#include <pxr/base/tf/enum.h>
+#include <pxr/base/tf/envSetting.h>
 #include <pxr/base/tf/registryManager.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/ar/asset.h>
@@ -28,8 +32,10 @@
 #include <boost/json/src.hpp>
 #pragma warning(pop)
 
+#include "../Kit.h"
 #include "Data.h"
 #include "Resolver.h"
+#include "ValuePool.h"
 
 #include <Logger/Logger.h>
 #include <Serialization/Api.h>
@@ -42,6 +48,38 @@ TF_DEFINE_PUBLIC_TOKENS(RenderStudioFileFormatTokens, RENDER_STUDIO_FILE_FORMAT_
 
 TF_REGISTRY_FUNCTION(TfType) { SDF_DEFINE_FILE_FORMAT(RenderStudioFileFormat, SdfFileFormat); }
 
+TF_DEFINE_ENV_SETTING(
+    RENDER_STUDIO_SEND_RATE,
+    0,
+    "Max number of delta messages sent per second for each layer, 0 sends local changes on every live update");
+
+TF_DEFINE_ENV_SETTING(
+    RENDER_STUDIO_SEND_BUDGET_KB,
+    0,
+    "Max kilobytes of deltas sent per second for each layer, 0 means no limit");
+
+TF_DEFINE_ENV_SETTING(
+    RENDER_STUDIO_INBOX_LIMIT,
+    256,
+    "Max number of remote deltas queued for each layer between live updates, newer ones are merged into the last "
+    "queued delta. 0 means no limit");
+
+TF_DEFINE_ENV_SETTING(
+    RENDER_STUDIO_IDLE_DELAY_MS,
+    100,
+    "Milliseconds without local edits after which pending values are final, live update is requested after that "
+    "to send or journal them");
+
+TF_DEFINE_ENV_SETTING(
+    RENDER_STUDIO_DECODE_THREADS,
+    2,
+    "Number of threads which decode incoming live messages, they're started with first message");
+
+TF_DEFINE_ENV_SETTING(
+    RENDER_STUDIO_STREAMING_LAYERS,
+    false,
+    "Read usdc layers lazily from memory mapped file, specs are loaded into memory only when they're edited");
+
 namespace
 {
 
@@ -126,6 +164,100 @@ ParseEvent(const std::string& message)
     }
 }
 
+// Spec erase requested with empty typeName, fields written after it belong to a new spec
+static bool
+_HasSpecErase(const RenderStudio::API::DeltaEvent& delta)
+{
+    for (const auto& [path, spec] : delta.updates)
+    {
+        for (const auto& [field, value] : spec.fields)
+        {
+            bool erase = field == SdfFieldKeys->TypeName && value.IsHolding<TfToken>()
+                && value.UncheckedGet<TfToken>().IsEmpty();
+
+            if (erase)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+static void
+_EraseField(std::vector<T>& ops, const TfToken& field)
+{
+    ops.erase(
+        std::remove_if(ops.begin(), ops.end(), [&field](const T& op) { return op.field == field; }), ops.end());
+}
+
+// Merges later delta of the same spec. Full write of a field drops earlier writes and ops of it,
+// ops are applied after fields, so later ops stay valid on top of earlier write
+static void
+_MergeSpec(RenderStudio::API::SpecData& target, RenderStudio::API::SpecData&& source)
+{
+    if (source.specType != SdfSpecTypeUnknown)
+    {
+        target.specType = source.specType;
+    }
+
+    for (auto& [field, value] : source.fields)
+    {
+        target.arrayDiffs.erase(
+            std::remove_if(
+                target.arrayDiffs.begin(),
+                target.arrayDiffs.end(),
+                [&field](const std::pair<TfToken, RenderStudio::API::ArrayDiff>& diff) { return diff.first == field; }),
+            target.arrayDiffs.end());
+        _EraseField(target.childrenOps, field);
+        _EraseField(target.dictionaryOps, field);
+        _EraseField(target.listOpEdits, field);
+
+        if (field == SdfDataTokens->TimeSamples)
+        {
+            target.timeSamples.clear();
+        }
+
+        auto it = std::find_if(
+            target.fields.begin(),
+            target.fields.end(),
+            [&field](const std::pair<TfToken, VtValue>& f) { return f.first == field; });
+
+        if (it != target.fields.end())
+        {
+            it->second = std::move(value);
+        }
+        else
+        {
+            target.fields.emplace_back(field, std::move(value));
+        }
+    }
+
+    for (RenderStudio::API::TimeSampleOp& op : source.timeSamples)
+    {
+        auto it = std::find_if(
+            target.timeSamples.begin(),
+            target.timeSamples.end(),
+            [&op](const RenderStudio::API::TimeSampleOp& sample) { return sample.time == op.time; });
+
+        if (it != target.timeSamples.end())
+        {
+            it->value = std::move(op.value);
+        }
+        else
+        {
+            target.timeSamples.push_back(std::move(op));
+        }
+    }
+
+    std::move(source.arrayDiffs.begin(), source.arrayDiffs.end(), std::back_inserter(target.arrayDiffs));
+    std::move(source.childrenOps.begin(), source.childrenOps.end(), std::back_inserter(target.childrenOps));
+    std::move(source.dictionaryOps.begin(), source.dictionaryOps.end(), std::back_inserter(target.dictionaryOps));
+    std::move(source.listOpEdits.begin(), source.listOpEdits.end(), std::back_inserter(target.listOpEdits));
+}
+
 template <typename... Ts> struct Overload : Ts...
 {
     using Ts::operator()...;
@@ -135,6 +267,12 @@ template <class... Ts> Overload(Ts...) -> Overload<Ts...>;
 
 } // namespace
 
+std::shared_ptr<const RenderStudioDataSnapshot>
+RenderStudioFileFormat::GetSnapshot(const SdfLayerHandle& layer) const
+{
+    return _GetRenderStudioData(layer)->GetSnapshot();
+}
+
 RenderStudioDataPtr
 RenderStudioFileFormat::_GetRenderStudioData(SdfLayerHandle layer) const
 {
@@ -163,18 +301,259 @@ RenderStudioFileFormat::_GetRenderStudioData(const SdfLayer& layer) const
     return TfConst_cast<RenderStudioDataPtr>(casted);
 }
 
+std::vector<RenderStudio::Kit::LiveSessionLayerStats>
+RenderStudioFileFormat::GetLiveStats()
+{
+    using Bucket = RenderStudioDataStats::Bucket;
+    auto convert = [](const Bucket& bucket)
+    { return RenderStudio::Kit::LiveSessionMemoryBucket { bucket.count, bucket.bytes }; };
+
+    std::vector<RenderStudio::Kit::LiveSessionLayerStats> result;
+
+    mLayerRegistry.ForEachLayer(
+        [this, &result, &convert](SdfLayerHandle layer)
+        {
+            RenderStudioDataPtr data = _GetRenderStudioData(layer);
+            const RenderStudioDataStats& stats = data->GetStats();
+
+            RenderStudio::Kit::LiveSessionLayerStats& entry = result.emplace_back();
+            entry.identifier = layer->GetIdentifier();
+            entry.total = convert(stats.GetTotal());
+
+            for (int i = 0; i < SdfNumSpecTypes; i++)
+            {
+                SdfSpecType specType = static_cast<SdfSpecType>(i);
+                if (stats.GetSpecType(specType).count > 0)
+                {
+                    entry.bySpecType[TfEnum::GetName(specType)] = convert(stats.GetSpecType(specType));
+                }
+            }
+
+            stats.ForEachField([&entry, &convert](const TfToken& field, const Bucket& bucket)
+                               { entry.byField[field.GetString()] = convert(bucket); });
+            stats.ForEachValueType([&entry, &convert](const std::string& type, const Bucket& bucket)
+                                   { entry.byValueType[type] = convert(bucket); });
+
+            entry.localDeltas = data->GetLocalDeltaCount();
+            entry.remoteUpdates = data->GetRemoteQueueSize();
+            entry.unacknowledgedFields = data->GetUnacknowledgedCount();
+            entry.subtreeEdits = data->GetSubtreeEditCount();
+        });
+
+    // Events received since last live update, not yet handed to layers, collapsed ones are counted as single
+    std::lock_guard<std::mutex> lock(mEventMutex);
+    for (RenderStudio::Kit::LiveSessionLayerStats& entry : result)
+    {
+        auto it = mAccumulatedDeltas.find(entry.identifier);
+        entry.accumulatedDeltas = it != mAccumulatedDeltas.end() ? it->second.size() : 0;
+    }
+
+    return result;
+}
+
+std::size_t
+RenderStudioFileFormat::GetBacklogDepth()
+{
+    std::lock_guard<std::mutex> lock(mEventMutex);
+
+    std::size_t depth = 0;
+    for (const auto& [layer, inbox] : mAccumulatedDeltas)
+    {
+        for (const _InboxDelta& delta : inbox)
+        {
+            depth += delta.lastSequence - delta.event.sequence.value() + 1;
+        }
+    }
+
+    return depth;
+}
+
+bool
+RenderStudioFileFormat::WaitForWork(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(mEventMutex);
+    return mWorkCondition.wait_for(lock, timeout, [this]() { return mHasPendingWork; });
+}
+
+void
+RenderStudioFileFormat::SetWorkCallback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(mEventMutex);
+    mWorkCallback = std::move(callback);
+}
+
+void
+RenderStudioFileFormat::_SignalWork()
+{
+    std::function<void()> callback;
+
+    {
+        std::lock_guard<std::mutex> lock(mEventMutex);
+
+        // Host is already woken up and didn't take events yet
+        if (mHasPendingWork)
+        {
+            return;
+        }
+
+        mHasPendingWork = true;
+        callback = mWorkCallback;
+    }
+
+    mWorkCondition.notify_all();
+
+    if (callback)
+    {
+        callback();
+    }
+}
+
+void
+RenderStudioFileFormat::_ScheduleWork(std::chrono::steady_clock::time_point time)
+{
+    {
+        std::lock_guard<std::mutex> lock(mEventMutex);
+        if (!mWakeThread.joinable())
+        {
+            mWakeThread = std::thread(&RenderStudioFileFormat::_WakeLoop, this);
+        }
+
+        mWakeTime = mWakeTime.has_value() ? std::min(mWakeTime.value(), time) : time;
+    }
+
+    mWakeCondition.notify_one();
+}
+
+void
+RenderStudioFileFormat::_WakeLoop()
+{
+    std::unique_lock<std::mutex> lock(mEventMutex);
+
+    while (!mWakeStopped)
+    {
+        if (!mWakeTime.has_value())
+        {
+            mWakeCondition.wait(lock);
+            continue;
+        }
+
+        // Schedule could change while waiting, it's checked again after each wake up
+        if (std::chrono::steady_clock::now() < mWakeTime.value())
+        {
+            mWakeCondition.wait_until(lock, mWakeTime.value());
+            continue;
+        }
+
+        mWakeTime.reset();
+        lock.unlock();
+        _SignalWork();
+        lock.lock();
+    }
+}
+
 bool
-RenderStudioFileFormat::ProcessLiveUpdates()
+RenderStudioFileFormat::_IsSendAllowed(_SendWindow& window, bool idle, std::chrono::steady_clock::time_point now)
+{
+    // Budget refills continuously, up to one second worth of bytes
+    if (mSendBudget > 0.0)
+    {
+        double elapsed = std::chrono::duration<double>(now - window.lastRefill).count();
+        window.credit = std::min(window.credit + elapsed * mSendBudget, mSendBudget);
+        window.lastRefill = now;
+    }
+
+    // Pending values are final ones, they go out right away
+    if (idle)
+    {
+        return true;
+    }
+
+    if (now - window.lastSend < mSendInterval)
+    {
+        return false;
+    }
+
+    return mSendBudget <= 0.0 || window.credit > 0.0;
+}
+
+bool
+RenderStudioFileFormat::_SendDelta(
+    RenderStudio::API::DeltaEvent&& body,
+    _SendWindow& window,
+    std::chrono::steady_clock::time_point now)
+{
+    try
+    {
+        body.user = RenderStudioResolver::GetCurrentUserId();
+        body.sequence = std::nullopt;
+        bool ephemeral = body.ephemeral;
+
+        RenderStudio::API::Event event { "Delta::Event", std::move(body) };
+        std::string message = boost::json::serialize(boost::json::value_from(event));
+        mWebsocketClient->Send(message);
+
+        window.lastSend = now;
+        window.credit -= static_cast<double>(message.size());
+
+        // Interactive values aren't acknowledged
+        if (!ephemeral)
+        {
+            window.sent += 1;
+        }
+
+        return true;
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_WARNING << ex.what();
+        return false;
+    }
+}
+
+void
+RenderStudioFileFormat::_WriteJournal(const std::string& layer, RenderStudioDataPtr data, _JournalState& state)
+{
+    if (!data->HasLocalDeltas())
+    {
+        mJournal.Remove(layer);
+        state.written = false;
+        state.replay = std::nullopt;
+        return;
+    }
+
+    RenderStudio::API::DeltaEvent journal;
+    journal.layer = layer;
+    journal.user = RenderStudioResolver::GetCurrentUserId();
+    journal.updates = data->CollectJournalDeltas();
+    journal.namespaceEdits = data->GetLocalNamespaceEdits();
+
+    mJournal.Write(journal);
+    state.written = true;
+    state.replay = std::nullopt;
+}
+
+bool
+RenderStudioFileFormat::ProcessLiveUpdates(
+    std::chrono::steady_clock::time_point deadline,
+    RenderStudio::Kit::LiveSessionUpdateResult* result)
 {
     bool updated = false;
+    bool interrupted = false;
+    std::size_t queued = 0;
+    mFrameArena.Reset();
 
     // Fetch all incoming events and release lock so newer events could be accumulated
     std::unique_lock<std::mutex> lock(mEventMutex);
     auto deltas = std::move(mAccumulatedDeltas);
     auto reloads = std::move(mRequestedReloads);
     auto acknowledges = std::move(mAccumulatedAcknowledges);
+    auto ephemeral = std::move(mAccumulatedEphemeral);
+    mHasPendingWork = false;
+    mWakeTime.reset();
     lock.unlock();
 
+    std::optional<std::chrono::steady_clock::time_point> wakeTime;
+
     // Process reloads. It's safe to do it from beginning, since we already discarded all the deltas before reloading
     mReloadInProgress = true;
     for (const std::string& id : reloads)
@@ -191,9 +570,27 @@ RenderStudioFileFormat::ProcessLiveUpdates()
     }
     mReloadInProgress = false;
 
+    // Only layers with pending work are visited. Layers with incoming events are marked here,
+    // local edits mark their layers themselves
+    for (const auto& [id, events] : deltas)
+    {
+        mLayerRegistry.MarkDirty(id);
+    }
+
+    for (const auto& [id, events] : acknowledges)
+    {
+        mLayerRegistry.MarkDirty(id);
+    }
+
+    for (const auto& [id, updates] : ephemeral)
+    {
+        mLayerRegistry.MarkDirty(id);
+    }
+
     // Process deltas
-    mLayerRegistry.ForEachLayer(
-        [this, &updated, &deltas, &reloads, &acknowledges](SdfLayerHandle layer)
+    mLayerRegistry.ForEachDirtyLayer(
+        [this, &updated, &interrupted, &queued, &wakeTime, &deltas, &reloads, &acknowledges, &ephemeral, deadline](
+            SdfLayerHandle layer)
         {
             RenderStudioDataPtr data = _GetRenderStudioData(layer);
 
@@ -203,67 +600,136 @@ RenderStudioFileFormat::ProcessLiveUpdates()
                 return;
             }
 
-            // Send local deltas
-            auto local = data->FetchLocalDeltas();
-            if (!local.empty())
+            // Edits left by previous run which exited without connection, they're restored once per layer
+            auto [journal, firstUpdate] = mJournalStates.try_emplace(layer->GetIdentifier());
+            if (firstUpdate)
             {
-                try
+                if (auto recovered = mJournal.Read(layer->GetIdentifier()); recovered.has_value())
                 {
-                    // Convert internal format to API update
-                    RenderStudio::API::DeltaEvent body;
-                    body.layer = layer->GetIdentifier();
-                    body.user = RenderStudioResolver::GetCurrentUserId();
-                    body.sequence = std::nullopt;
+                    LOG_INFO << "Restoring offline edits of " << layer->GetIdentifier();
+                    data->RestoreJournalDeltas(layer, recovered.value());
+                    journal->second.written = true;
+                    updated = true;
+                }
+            }
+
+            // Send local deltas. Edits made until next send are coalesced, only latest value of each field is sent
+            auto now = std::chrono::steady_clock::now();
+            _SendWindow& window = mSendWindows[layer->GetIdentifier()];
 
-                    for (const auto& [key, value] : local)
+            // Nothing was edited since previous live update means user stopped, so pending values are final
+            std::size_t revision = data->GetLocalRevision();
+            bool idle = revision == window.revision;
+            window.revision = revision;
+
+            // Without connection edits stay pending in data, journal is rewritten each time user stops editing.
+            // Deltas sent before disconnect are never acknowledged, counting starts over with next connection
+            if (!mConnected)
+            {
+                window.sent = 0;
+                window.acknowledged = 0;
+
+                if (idle && revision != journal->second.revision)
+                {
+                    _WriteJournal(layer->GetIdentifier(), data, journal->second);
+                    journal->second.revision = revision;
+                }
+            }
+            else if (data->HasLocalDeltas() && _IsSendAllowed(window, idle, now))
+            {
+                // Journaled edits are replayed as single delta, including interactive ones
+                bool replay = journal->second.written && !journal->second.replay.has_value();
+
+                // Convert internal format to API update
+                RenderStudio::API::DeltaEvent body;
+                body.layer = layer->GetIdentifier();
+                body.updates = data->FetchLocalDeltas(idle || replay);
+                body.namespaceEdits = data->FetchLocalNamespaceEdits();
+
+                // Drag in progress, transform values are relayed to others without going to history
+                RenderStudio::API::DeltaEvent interactive;
+                interactive.layer = layer->GetIdentifier();
+                interactive.updates = idle ? RenderStudio::API::DeltaTable {} : data->CollectEphemeralDeltas();
+                interactive.ephemeral = true;
+
+                if (!body.updates.empty() || !body.namespaceEdits.empty())
+                {
+                    if (_SendDelta(std::move(body), window, now) && replay)
                     {
-                        body.updates[key] = RenderStudio::API::SpecData { value.specType, value.fields };
+                        journal->second.replay = window.sent;
                     }
-
-                    RenderStudio::API::Event event { "Delta::Event", body };
-                    mWebsocketClient->Send(boost::json::serialize(boost::json::value_from(event)));
                 }
-                catch (const std::exception& ex)
+
+                if (!interactive.updates.empty())
                 {
-                    LOG_WARNING << ex.what();
+                    _SendDelta(std::move(interactive), window, now);
                 }
             }
 
             // Accumulate remote acknowledges inside data
             if (auto it = acknowledges.find(layer->GetIdentifier()); it != acknowledges.end())
             {
+                // Acknowledges come in order of sent deltas, ones received before replay was sent are for earlier ones
+                window.acknowledged = std::min(window.acknowledged + it->second.size(), window.sent);
+                if (journal->second.replay.has_value() && window.acknowledged >= journal->second.replay.value())
+                {
+                    mJournal.Remove(layer->GetIdentifier());
+                    journal->second.written = false;
+                    journal->second.replay = std::nullopt;
+                }
+
                 for (const RenderStudio::API::AcknowledgeEvent& acknowledge : it->second)
                 {
                     // Convert API update to internal format
-                    RenderStudioData::_HashTable updates;
+                    RenderStudioData::_DeltaTable updates;
                     for (const auto& path : acknowledge.paths)
                     {
-                        updates[path] = RenderStudioData::_SpecData {};
+                        updates[path] = RenderStudio::API::SpecData {};
                     }
-                    data->AccumulateRemoteUpdate(updates, acknowledge.sequence);
+                    data->AccumulateRemoteUpdate(std::move(updates), {}, acknowledge.sequence, acknowledge.sequence);
                 }
             }
 
+            // Accumulate interactive values of other users inside data
+            if (auto it = ephemeral.find(layer->GetIdentifier()); it != ephemeral.end())
+            {
+                data->AccumulateEphemeralUpdate(std::move(it->second));
+                updated = true;
+            }
+
             // Accumulate remote deltas inside data
             if (auto it = deltas.find(layer->GetIdentifier()); it != deltas.end())
             {
-                for (const RenderStudio::API::DeltaEvent& delta : it->second)
+                for (_InboxDelta& delta : it->second)
                 {
-                    // Convert API update to internal format
-                    RenderStudioData::_HashTable updates;
-                    for (const auto& [key, value] : delta.updates)
-                    {
-                        RenderStudioData::_SpecData spec;
-                        spec.specType = value.specType;
-                        spec.fields = value.fields;
-                        updates[key] = spec;
-                    }
-                    data->AccumulateRemoteUpdate(updates, delta.sequence.value());
+                    data->AccumulateRemoteUpdate(
+                        std::move(delta.event.updates),
+                        std::move(delta.event.namespaceEdits),
+                        delta.event.sequence.value(),
+                        delta.lastSequence);
                 }
             }
 
             std::size_t sequence = data->GetSequence();
-            data->ProcessRemoteUpdates(layer);
+            bool layerInterrupted = data->ProcessRemoteUpdates(layer, mFrameArena.GetResource(), deadline);
+            interrupted = interrupted || layerInterrupted;
+            queued += data->GetRemoteQueueSize();
+
+            // Unsent local deltas and updates left after deadline need next live update too.
+            // Updates waiting for a gap in sequence are marked once missing event arrives
+            if (layerInterrupted || data->HasLocalDeltas())
+            {
+                mLayerRegistry.MarkDirty(layer->GetIdentifier());
+            }
+
+            // Host might not come back by itself. Pending edits are final if nothing changes until idle delay passes,
+            // without connection only edits which aren't journaled yet count
+            bool pending = mConnected ? data->HasLocalDeltas() : revision != journal->second.revision;
+            if (pending && !layerInterrupted)
+            {
+                auto time = now + mIdleDelay;
+                wakeTime = wakeTime.has_value() ? std::min(wakeTime.value(), time) : time;
+            }
 
             // Changed sequence number means there was an applied update
             if (sequence != data->GetSequence())
@@ -272,6 +738,31 @@ RenderStudioFileFormat::ProcessLiveUpdates()
             }
         });
 
+    // Updates left after deadline, along with ones received during this live update
+    if (result != nullptr)
+    {
+        result->remaining = queued + GetBacklogDepth();
+        result->arenaHeapAllocations = mFrameArena.GetHeapAllocations();
+        result->arenaHeapBytes = mFrameArena.GetHeapBytes();
+    }
+
+    // Host is told right away to come back for what's left, signal is raised by wake thread after this call returns
+    if (interrupted)
+    {
+        _ScheduleWork(std::chrono::steady_clock::now());
+    }
+    else if (wakeTime.has_value())
+    {
+        _ScheduleWork(wakeTime.value());
+    }
+
+    // Should stay zero in steady state, arena buffer grows after each update which didn't fit
+    if (mFrameArena.GetHeapAllocations() > 0)
+    {
+        LOG_DEBUG << "Live update made " << mFrameArena.GetHeapAllocations() << " arena heap allocations, "
+                  << mFrameArena.GetHeapBytes() << " bytes";
+    }
+
     return updated;
 }
 
@@ -331,10 +822,36 @@ RenderStudioFileFormat::_InstantiateNewLayer(
     return layer;
 }
 
+SdfFileFormatConstPtr
+RenderStudioFileFormat::_GetCachedOriginalFormat(const std::string& path) const
+{
+    // Remote paths have no write time, they are cached until process exit
+    std::error_code error;
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+    if (error)
+    {
+        writeTime = std::filesystem::file_time_type {};
+    }
+
+    std::unique_lock<std::mutex> lock(mFormatCacheMutex);
+    auto it = mFormatCache.find(path);
+    if (it != mFormatCache.end() && it->second.writeTime == writeTime)
+    {
+        return it->second.format;
+    }
+    lock.unlock();
+
+    SdfFileFormatConstPtr format = _GetOriginalFormat(path);
+
+    lock.lock();
+    mFormatCache[path] = _FormatCacheEntry { format, writeTime };
+    return format;
+}
+
 bool
 RenderStudioFileFormat::CanRead(const std::string& file) const
 {
-    SdfFileFormatConstPtr format = _GetOriginalFormat(file);
+    SdfFileFormatConstPtr format = _GetCachedOriginalFormat(file);
 
     if (format == nullptr)
     {
@@ -347,7 +864,7 @@ RenderStudioFileFormat::CanRead(const std::string& file) const
 bool
 RenderStudioFileFormat::Read(SdfLayer* layer, const std::string& resolvedPath, bool metadataOnly) const
 {
-    SdfFileFormatConstPtr format = _GetOriginalFormat(resolvedPath);
+    SdfFileFormatConstPtr format = _GetCachedOriginalFormat(resolvedPath);
 
     if (format == nullptr)
     {
@@ -361,10 +878,19 @@ RenderStudioFileFormat::Read(SdfLayer* layer, const std::string& resolvedPath, b
         return result;
     }
 
-    // USD uses own format of data. Current approach is to copy it into RenderStudioData
-    SdfAbstractDataConstPtr abstractData = SdfFileFormat::_GetLayerData(*layer);
-    SdfAbstractDataRefPtr renderStudioData = InitData(GetDefaultFileFormatArguments());
-    renderStudioData->CopyFrom(abstractData);
+    // USD uses own format of data. RenderStudioData either streams from crate data or takes over its specs
+    SdfAbstractDataPtr abstractData = TfConst_cast<SdfAbstractDataPtr>(SdfFileFormat::_GetLayerData(*layer));
+    RenderStudioDataRefPtr renderStudioData = TfCreateRefPtr(new RenderStudioData);
+
+    bool streaming = TfGetEnvSetting(RENDER_STUDIO_STREAMING_LAYERS)
+        && format->GetFormatId() == UsdUsdcFileFormatTokens->Id && abstractData->StreamsData()
+        && renderStudioData->AttachBackingData(TfCreateRefPtrFromProtectedWeakPtr(abstractData), resolvedPath);
+
+    if (!streaming)
+    {
+        renderStudioData->AdoptFrom(abstractData);
+    }
+
     SdfFileFormat::_SetLayerData(layer, renderStudioData);
 
     // Here's first time layer read
@@ -374,6 +900,12 @@ RenderStudioFileFormat::Read(SdfLayer* layer, const std::string& resolvedPath, b
         mLayerRegistry.AddLayer(SdfLayerHandle { layer });
     }
 
+    // Reloaded layer drops pending local edits, so does its journal
+    if (!firstTimeLoading)
+    {
+        mJournal.Remove(layer->GetIdentifier());
+    }
+
     // Notify other clients about reloading if we initiated it
     if (!mReloadInProgress && mWebsocketClient != nullptr && !firstTimeLoading)
     {
@@ -387,6 +919,7 @@ RenderStudioFileFormat::Read(SdfLayer* layer, const std::string& resolvedPath, b
     }
 
     _GetRenderStudioData(SdfLayerHandle { layer })->SetOriginalFormat(format);
+    _GetRenderStudioData(SdfLayerHandle { layer })->SetLayerRegistry(&mLayerRegistry, layer->GetIdentifier());
     _GetRenderStudioData(SdfLayerHandle { layer })->OnLoaded();
 
     return result;
@@ -408,6 +941,14 @@ RenderStudioFileFormat::WriteToFile(
     }
 
     std::string resolvedPath = RenderStudioResolver::ResolveImpl(filePath);
+
+    // Crate file can't be overwritten while it's still mapped for reading
+    RenderStudioDataPtr data = _GetRenderStudioData(layer);
+    if (data->StreamsData() && data->GetBackingPath() == resolvedPath)
+    {
+        data->DetachBackingData();
+    }
+
     return format->WriteToFile(layer, resolvedPath, comment, args);
 }
 
@@ -418,6 +959,13 @@ RenderStudioFileFormat::RenderStudioFileFormat()
         RenderStudioFileFormatTokens->Target,
         RenderStudioFileFormatTokens->Id)
 {
+    int rate = TfGetEnvSetting(RENDER_STUDIO_SEND_RATE);
+    int budget = TfGetEnvSetting(RENDER_STUDIO_SEND_BUDGET_KB);
+
+    mSendInterval = std::chrono::duration<double>(rate > 0 ? 1.0 / rate : 0.0);
+    mSendBudget = budget > 0 ? budget * 1024.0 : 0.0;
+    mInboxLimit = static_cast<std::size_t>(std::max(TfGetEnvSetting(RENDER_STUDIO_INBOX_LIMIT), 0));
+    mIdleDelay = std::chrono::milliseconds(std::max(TfGetEnvSetting(RENDER_STUDIO_IDLE_DELAY_MS), 0));
 }
 
 RenderStudioFileFormat::~RenderStudioFileFormat()
@@ -426,11 +974,49 @@ RenderStudioFileFormat::~RenderStudioFileFormat()
     {
         mWebsocketClient->Disconnect();
     }
+
+    // Queued messages are dropped, the one being decoded is finished
+    {
+        std::lock_guard<std::mutex> lock(mDecodeMutex);
+        mDecodeStopped = true;
+        mDecodeQueue.clear();
+    }
+
+    mDecodeCondition.notify_all();
+
+    for (std::thread& worker : mDecodeWorkers)
+    {
+        worker.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mEventMutex);
+        mWakeStopped = true;
+    }
+
+    mWakeCondition.notify_all();
+
+    if (mWakeThread.joinable())
+    {
+        mWakeThread.join();
+    }
 }
 
 void
-RenderStudioFileFormat::ProcessDeltaEvent(const RenderStudio::API::DeltaEvent& v)
+RenderStudioFileFormat::ProcessDeltaEvent(RenderStudio::API::DeltaEvent&& v)
 {
+    // Interactive values have no sequence, only latest value of each attribute is kept until next live update
+    if (v.ephemeral)
+    {
+        std::lock_guard<std::mutex> lock(mEventMutex);
+        RenderStudio::API::DeltaTable& latest = mAccumulatedEphemeral[v.layer];
+        for (auto& [path, spec] : v.updates)
+        {
+            latest[path] = std::move(spec);
+        }
+        return;
+    }
+
     if (!v.sequence.has_value())
     {
         LOG_WARNING << "Got update without sequence number";
@@ -438,7 +1024,29 @@ RenderStudioFileFormat::ProcessDeltaEvent(const RenderStudio::API::DeltaEvent& v
     }
 
     std::lock_guard<std::mutex> lock(mEventMutex);
-    mAccumulatedDeltas[v.layer].push_back(v);
+    std::vector<_InboxDelta>& inbox = mAccumulatedDeltas[v.layer];
+    std::size_t sequence = v.sequence.value();
+
+    // Host isn't updating for a while. Newer deltas are merged into the last queued one instead of piling up,
+    // merge is possible only for contiguous sequences, gaps are own deltas which server acknowledges separately
+    if (mInboxLimit > 0 && inbox.size() >= mInboxLimit)
+    {
+        _InboxDelta& last = inbox.back();
+        if (last.open && last.lastSequence + 1 == sequence && v.namespaceEdits.empty() && !_HasSpecErase(v))
+        {
+            for (auto& [path, spec] : v.updates)
+            {
+                _MergeSpec(last.event.updates[path], std::move(spec));
+            }
+
+            last.lastSequence = sequence;
+            return;
+        }
+    }
+
+    // Fields written after spec erase belong to a new spec, such delta is never merged with later ones
+    bool open = !_HasSpecErase(v);
+    inbox.push_back(_InboxDelta { std::move(v), sequence, open });
 }
 
 void
@@ -472,6 +1080,7 @@ RenderStudioFileFormat::ProcessReloadEvent(const RenderStudio::API::ReloadEvent&
     {
         mAccumulatedDeltas.erase(it);
     }
+    mAccumulatedEphemeral.erase(v.layer);
 
     // Clear all acknowledges that happen before reload, data would be re-created so not use them
     if (auto it = mAccumulatedAcknowledges.find(v.layer); it != mAccumulatedAcknowledges.end())
@@ -487,6 +1096,10 @@ void
 RenderStudioFileFormat::OnConnected()
 {
     LOG_INFO << "Connected RenderStudioKit with remote Live server";
+    mConnected = true;
+
+    // Journaled edits are replayed by live update
+    _SignalWork();
     RenderStudioNotice::LiveConnectionChanged(true).Send();
 }
 
@@ -494,25 +1107,106 @@ void
 RenderStudioFileFormat::OnDisconnected()
 {
     LOG_INFO << "Disconnected RenderStudioKit from remote Live server";
+    mConnected = false;
     RenderStudioNotice::LiveConnectionChanged(false).Send();
 }
 
 void
 RenderStudioFileFormat::OnMessage(const std::string& message)
+{
+    // Called from websocket thread only, so index is order of arrival
+    {
+        std::lock_guard<std::mutex> lock(mDecodeMutex);
+        if (mDecodeWorkers.empty())
+        {
+            int count = std::max(TfGetEnvSetting(RENDER_STUDIO_DECODE_THREADS), 1);
+            for (int i = 0; i < count; i++)
+            {
+                mDecodeWorkers.emplace_back(&RenderStudioFileFormat::_DecodeLoop, this);
+            }
+        }
+
+        mDecodeQueue.emplace_back(mReceivedCount++, message);
+    }
+
+    mDecodeCondition.notify_one();
+}
+
+void
+RenderStudioFileFormat::_DecodeLoop()
+{
+    std::unique_lock<std::mutex> lock(mDecodeMutex);
+
+    while (true)
+    {
+        mDecodeCondition.wait(lock, [this]() { return mDecodeStopped || !mDecodeQueue.empty(); });
+        if (mDecodeStopped)
+        {
+            return;
+        }
+
+        auto [index, message] = std::move(mDecodeQueue.front());
+        mDecodeQueue.pop_front();
+
+        lock.unlock();
+        _DecodeMessage(index, message);
+        lock.lock();
+    }
+}
+
+void
+RenderStudioFileFormat::_DecodeMessage(std::size_t index, const std::string& message)
 {
     auto event = ParseEvent(message);
 
-    if (!event.has_value())
+    // Decoded values are deduplicated here, so USD thread gets them already shared
+    RenderStudioValuePool& pool = RenderStudioValuePool::GetInstance();
+    if (event.has_value() && pool.IsEnabled())
     {
-        return;
+        if (auto* delta = std::get_if<RenderStudio::API::DeltaEvent>(&event.value().body); delta != nullptr)
+        {
+            for (auto& [path, spec] : delta->updates)
+            {
+                for (auto& [field, value] : spec.fields)
+                {
+                    pool.Intern(value);
+                }
+            }
+        }
     }
 
-    std::visit(
-        Overload { [this](const RenderStudio::API::DeltaEvent& v) { ProcessDeltaEvent(v); },
-                   [this](const RenderStudio::API::HistoryEvent& v) { ProcessHistoryEvent(v); },
-                   [this](const RenderStudio::API::AcknowledgeEvent& v) { ProcessAcknowledgeEvent(v); },
-                   [this](const RenderStudio::API::ReloadEvent& v) { ProcessReloadEvent(v); } },
-        event.value().body);
+    std::unique_lock<std::mutex> lock(mDecodeMutex);
+    mDecodedEvents.emplace(index, std::move(event));
+    bool actionable = false;
+
+    // Reorder buffer. Events are handed over only once all earlier ones are decoded, e.g. reload can't overtake
+    // deltas received before it
+    for (auto it = mDecodedEvents.find(mDispatchedCount); it != mDecodedEvents.end();
+         it = mDecodedEvents.find(mDispatchedCount))
+    {
+        if (it->second.has_value())
+        {
+            // History status is sent as notice right away, everything else waits for live update
+            actionable = actionable || !std::holds_alternative<RenderStudio::API::HistoryEvent>(it->second->body);
+
+            std::visit(
+                Overload { [this](RenderStudio::API::DeltaEvent& v) { ProcessDeltaEvent(std::move(v)); },
+                           [this](const RenderStudio::API::HistoryEvent& v) { ProcessHistoryEvent(v); },
+                           [this](const RenderStudio::API::AcknowledgeEvent& v) { ProcessAcknowledgeEvent(v); },
+                           [this](const RenderStudio::API::ReloadEvent& v) { ProcessReloadEvent(v); } },
+                it->second.value().body);
+        }
+
+        mDecodedEvents.erase(it);
+        mDispatchedCount += 1;
+    }
+
+    lock.unlock();
+
+    if (actionable)
+    {
+        _SignalWork();
+    }
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
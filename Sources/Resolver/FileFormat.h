@@ -15,6 +15,16 @@
 #pragma once
 
 #pragma warning(push, 0)
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <vector>
 
 #include <pxr/base/tf/declarePtrs.h>
@@ -27,9 +37,17 @@
 #pragma warning(pop)
 
 #include "Data.h"
+#include "FrameArena.h"
+#include "Journal.h"
 #include "Networking/WebsocketClient.h"
 #include "Registry.h"
 
+namespace RenderStudio::Kit
+{
+struct LiveSessionLayerStats;
+struct LiveSessionUpdateResult;
+}
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 #define RENDER_STUDIO_FILE_FORMAT_TOKENS ((Id, "studio"))((Version, "1.0"))((Target, "usd"))
@@ -72,6 +90,10 @@ public:
         const std::string& comment = std::string(),
         const FileFormatArguments& args = FileFormatArguments()) const override;
 
+    /// Thread safe read-only view of live layer data, see RenderStudioData::GetSnapshot
+    AR_API
+    std::shared_ptr<const RenderStudioDataSnapshot> GetSnapshot(const SdfLayerHandle& layer) const;
+
     // IClientLogic implementation
     virtual void OnConnected() override;
     virtual void OnDisconnected() override;
@@ -83,25 +105,125 @@ private:
     RenderStudioFileFormat();
     virtual ~RenderStudioFileFormat();
 
-    bool ProcessLiveUpdates();
+    bool ProcessLiveUpdates(
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(),
+        RenderStudio::Kit::LiveSessionUpdateResult* result = nullptr);
+    std::vector<RenderStudio::Kit::LiveSessionLayerStats> GetLiveStats();
+    std::size_t GetBacklogDepth();
+    bool WaitForWork(std::chrono::milliseconds timeout);
+    void SetWorkCallback(std::function<void()> callback);
     void Connect(const std::string& url);
     void Disconnect();
     RenderStudioDataPtr _GetRenderStudioData(SdfLayerHandle layer) const;
     RenderStudioDataPtr _GetRenderStudioData(const SdfLayer& layer) const;
+    SdfFileFormatConstPtr _GetCachedOriginalFormat(const std::string& path) const;
 
     friend class RenderStudioResolver;
     mutable RenderStudioLayerRegistry mLayerRegistry;
+
+    // Detected original format per resolved path, sniffing requires opening the file
+    struct _FormatCacheEntry
+    {
+        SdfFileFormatConstPtr format;
+        std::filesystem::file_time_type writeTime;
+    };
+
+    mutable std::map<std::string, _FormatCacheEntry> mFormatCache;
+    mutable std::mutex mFormatCacheMutex;
     std::shared_ptr<RenderStudio::Networking::WebsocketClient> mWebsocketClient;
+    std::atomic<bool> mConnected { false };
+
+    // Received delta, once inbox limit is reached following contiguous deltas are merged into it
+    struct _InboxDelta
+    {
+        RenderStudio::API::DeltaEvent event;
+        std::size_t lastSequence = 0;
+        bool open = false;
+    };
 
     // Main logic
-    std::map<std::string, std::vector<RenderStudio::API::DeltaEvent>> mAccumulatedDeltas;
+    std::map<std::string, std::vector<_InboxDelta>> mAccumulatedDeltas;
     std::map<std::string, std::vector<RenderStudio::API::AcknowledgeEvent>> mAccumulatedAcknowledges;
+    std::map<std::string, RenderStudio::API::DeltaTable> mAccumulatedEphemeral;
     std::vector<std::string> mRequestedReloads;
     std::mutex mEventMutex;
+    std::size_t mInboxLimit = 0;
+
+    // Raised once actionable events arrive, until next live update takes them
+    bool mHasPendingWork = false;
+    std::condition_variable mWorkCondition;
+    std::function<void()> mWorkCallback;
+
+    void _SignalWork();
+
+    // Live update which left work for later schedules the signal, wake thread raises it once time comes.
+    // So host is woken up without new events too, and callback never runs inside live update itself
+    std::optional<std::chrono::steady_clock::time_point> mWakeTime;
+    std::condition_variable mWakeCondition;
+    bool mWakeStopped = false;
+    std::thread mWakeThread;
+    std::chrono::milliseconds mIdleDelay { 0 };
+
+    void _ScheduleWork(std::chrono::steady_clock::time_point time);
+    void _WakeLoop();
     bool mReloadInProgress = false;
 
+    // Tables which live during single ProcessLiveUpdates call
+    RenderStudioFrameArena mFrameArena;
+
+    // Outgoing throttling, state is kept per layer identifier
+    struct _SendWindow
+    {
+        std::chrono::steady_clock::time_point lastSend;
+        std::chrono::steady_clock::time_point lastRefill;
+        std::size_t revision = 0;
+        double credit = 0.0;
+
+        // Deltas which go to history, server acknowledges them in order they were sent
+        std::size_t sent = 0;
+        std::size_t acknowledged = 0;
+    };
+
+    std::map<std::string, _SendWindow> mSendWindows;
+    std::chrono::duration<double> mSendInterval { 0.0 };
+    double mSendBudget = 0.0;
+
+    // Local edits made while disconnected are journaled on disk, journal is kept until replay is acknowledged
+    struct _JournalState
+    {
+        std::size_t revision = 0;
+        bool written = false;
+
+        // Number of sent deltas including replayed one, journal is removed once as many are acknowledged
+        std::optional<std::size_t> replay;
+    };
+
+    RenderStudioJournal mJournal;
+    std::map<std::string, _JournalState> mJournalStates;
+
+    void _WriteJournal(const std::string& layer, RenderStudioDataPtr data, _JournalState& state);
+    bool _IsSendAllowed(_SendWindow& window, bool idle, std::chrono::steady_clock::time_point now);
+    bool _SendDelta(
+        RenderStudio::API::DeltaEvent&& body,
+        _SendWindow& window,
+        std::chrono::steady_clock::time_point now);
+
+    // Incoming frames are decoded and prepared on own worker threads, then handed over in order of arrival.
+    // Workers don't depend on USD thread pool, so limited or busy pool can't stall decoding
+    void _DecodeLoop();
+    void _DecodeMessage(std::size_t index, const std::string& message);
+
+    std::mutex mDecodeMutex;
+    std::condition_variable mDecodeCondition;
+    std::deque<std::pair<std::size_t, std::string>> mDecodeQueue;
+    std::map<std::size_t, std::optional<RenderStudio::API::Event>> mDecodedEvents;
+    std::size_t mReceivedCount = 0;
+    std::size_t mDispatchedCount = 0;
+    bool mDecodeStopped = false;
+    std::vector<std::thread> mDecodeWorkers;
+
     // Processing methods
-    void ProcessDeltaEvent(const RenderStudio::API::DeltaEvent& v);
+    void ProcessDeltaEvent(RenderStudio::API::DeltaEvent&& v);
     void ProcessHistoryEvent(const RenderStudio::API::HistoryEvent& v);
     void ProcessAcknowledgeEvent(const RenderStudio::API::AcknowledgeEvent& v);
     void ProcessReloadEvent(const RenderStudio::API::ReloadEvent& v);
@@ -0,0 +1,344 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <pxr/pxr.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Open addressing hash map with linear probing and backward shift deletion.
+/// All entries live in one contiguous array, so lookups don't chase per-node allocations like TfHashMap does.
+/// Hashes are cached next to the entries (zero marks an empty slot), so probing rarely compares keys.
+/// Any insertion or erase may move entries, which invalidates iterators, pointers and references.
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class RenderStudioFlatHashMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = std::size_t;
+
+    template <class Map, class Value> class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename RenderStudioFlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        Iterator() = default;
+
+        Iterator(Map* map, std::size_t index)
+            : mMap(map)
+            , mIndex(index)
+        {
+            SkipEmpty();
+        }
+
+        // Allows iterator -> const_iterator conversion
+        template <class OtherMap, class OtherValue>
+        Iterator(const Iterator<OtherMap, OtherValue>& other)
+            : mMap(other.mMap)
+            , mIndex(other.mIndex)
+        {
+        }
+
+        reference operator*() const { return mMap->mSlots[mIndex]; }
+        pointer operator->() const { return &mMap->mSlots[mIndex]; }
+
+        Iterator& operator++()
+        {
+            ++mIndex;
+            SkipEmpty();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        template <class OtherMap, class OtherValue> bool operator==(const Iterator<OtherMap, OtherValue>& other) const
+        {
+            return mIndex == other.mIndex;
+        }
+
+        template <class OtherMap, class OtherValue> bool operator!=(const Iterator<OtherMap, OtherValue>& other) const
+        {
+            return mIndex != other.mIndex;
+        }
+
+    private:
+        template <class, class> friend class Iterator;
+        friend class RenderStudioFlatHashMap;
+
+        void SkipEmpty()
+        {
+            while (mIndex < mMap->mHashes.size() && mMap->mHashes[mIndex] == 0)
+            {
+                ++mIndex;
+            }
+        }
+
+        Map* mMap = nullptr;
+        std::size_t mIndex = 0;
+    };
+
+    using iterator = Iterator<RenderStudioFlatHashMap, value_type>;
+    using const_iterator = Iterator<const RenderStudioFlatHashMap, const value_type>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, mHashes.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, mHashes.size()); }
+
+    bool empty() const { return mSize == 0; }
+    size_type size() const { return mSize; }
+    size_type capacity() const { return mHashes.size(); }
+
+    void clear()
+    {
+        mHashes.clear();
+        mSlots.clear();
+        mSize = 0;
+        mShift = 64;
+    }
+
+    void reserve(size_type count)
+    {
+        size_type required = 16;
+        while (required * kMaxLoadNumerator < count * kMaxLoadDenominator)
+        {
+            required *= 2;
+        }
+
+        if (required > mHashes.size())
+        {
+            Rehash(required);
+        }
+    }
+
+    iterator find(const Key& key) { return iterator(this, FindIndex(key)); }
+    const_iterator find(const Key& key) const { return const_iterator(this, FindIndex(key)); }
+    size_type count(const Key& key) const { return FindIndex(key) != mHashes.size() ? 1 : 0; }
+
+    template <class... Args> std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        std::size_t hash = HashOf(key);
+        std::size_t index = FindIndex(key, hash);
+
+        if (index != mHashes.size())
+        {
+            return { iterator(this, index), false };
+        }
+
+        GrowIfRequired();
+        value_type value(
+            std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        index = InsertUnique(hash, std::move(value));
+        return { iterator(this, index), true };
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        std::size_t hash = HashOf(value.first);
+        std::size_t index = FindIndex(value.first, hash);
+
+        if (index != mHashes.size())
+        {
+            return { iterator(this, index), false };
+        }
+
+        GrowIfRequired();
+        index = InsertUnique(hash, std::move(value));
+        return { iterator(this, index), true };
+    }
+
+    T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    T& at(const Key& key)
+    {
+        std::size_t index = FindIndex(key);
+        if (index == mHashes.size())
+        {
+            throw std::out_of_range("RenderStudioFlatHashMap::at");
+        }
+        return mSlots[index].second;
+    }
+
+    const T& at(const Key& key) const
+    {
+        std::size_t index = FindIndex(key);
+        if (index == mHashes.size())
+        {
+            throw std::out_of_range("RenderStudioFlatHashMap::at");
+        }
+        return mSlots[index].second;
+    }
+
+    void erase(const_iterator position) { EraseIndex(position.mIndex); }
+
+    size_type erase(const Key& key)
+    {
+        std::size_t index = FindIndex(key);
+        if (index == mHashes.size())
+        {
+            return 0;
+        }
+        EraseIndex(index);
+        return 1;
+    }
+
+    void swap(RenderStudioFlatHashMap& other)
+    {
+        mHashes.swap(other.mHashes);
+        mSlots.swap(other.mSlots);
+        std::swap(mSize, other.mSize);
+        std::swap(mShift, other.mShift);
+    }
+
+private:
+    // Keep load factor under 3/4, linear probing degrades quickly above that
+    static constexpr std::size_t kMaxLoadNumerator = 3;
+    static constexpr std::size_t kMaxLoadDenominator = 4;
+
+    static std::size_t HashOf(const Key& key)
+    {
+        std::size_t hash = Hash {}(key);
+        return hash == 0 ? 1 : hash;
+    }
+
+    // Fibonacci hashing spreads weak low bits (pointer based hashes) over the whole table
+    std::size_t HomeOf(std::size_t hash) const
+    {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 11400714819323198485ull) >> mShift);
+    }
+
+    std::size_t FindIndex(const Key& key) const { return FindIndex(key, HashOf(key)); }
+
+    std::size_t FindIndex(const Key& key, std::size_t hash) const
+    {
+        if (mSize == 0)
+        {
+            return mHashes.size();
+        }
+
+        std::size_t mask = mHashes.size() - 1;
+        for (std::size_t index = HomeOf(hash);; index = (index + 1) & mask)
+        {
+            if (mHashes[index] == 0)
+            {
+                return mHashes.size();
+            }
+
+            if (mHashes[index] == hash && KeyEqual {}(mSlots[index].first, key))
+            {
+                return index;
+            }
+        }
+    }
+
+    std::size_t InsertUnique(std::size_t hash, value_type&& value)
+    {
+        std::size_t mask = mHashes.size() - 1;
+        std::size_t index = HomeOf(hash);
+
+        while (mHashes[index] != 0)
+        {
+            index = (index + 1) & mask;
+        }
+
+        mHashes[index] = hash;
+        mSlots[index] = std::move(value);
+        mSize += 1;
+        return index;
+    }
+
+    void GrowIfRequired()
+    {
+        if ((mSize + 1) * kMaxLoadDenominator > mHashes.size() * kMaxLoadNumerator)
+        {
+            Rehash(mHashes.empty() ? 16 : mHashes.size() * 2);
+        }
+    }
+
+    void Rehash(std::size_t capacity)
+    {
+        std::vector<std::size_t> hashes(capacity, 0);
+        std::vector<value_type> slots(capacity);
+        hashes.swap(mHashes);
+        slots.swap(mSlots);
+
+        mShift = 64;
+        for (std::size_t i = capacity; i > 1; i >>= 1)
+        {
+            mShift -= 1;
+        }
+
+        mSize = 0;
+        for (std::size_t i = 0; i < hashes.size(); i++)
+        {
+            if (hashes[i] != 0)
+            {
+                InsertUnique(hashes[i], std::move(slots[i]));
+            }
+        }
+    }
+
+    void EraseIndex(std::size_t index)
+    {
+        std::size_t mask = mHashes.size() - 1;
+        std::size_t hole = index;
+
+        // Shift following entries of the same cluster back, so lookups never need tombstones
+        for (std::size_t next = (hole + 1) & mask; mHashes[next] != 0; next = (next + 1) & mask)
+        {
+            std::size_t home = HomeOf(mHashes[next]);
+            bool movable = hole <= next ? (home <= hole || home > next) : (home <= hole && home > next);
+
+            if (movable)
+            {
+                mHashes[hole] = mHashes[next];
+                mSlots[hole] = std::move(mSlots[next]);
+                hole = next;
+            }
+        }
+
+        mHashes[hole] = 0;
+        mSlots[hole] = value_type {};
+        mSize -= 1;
+    }
+
+    std::vector<std::size_t> mHashes;
+    std::vector<value_type> mSlots;
+    std::size_t mSize = 0;
+    std::size_t mShift = 64;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
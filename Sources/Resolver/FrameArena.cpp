@@ -0,0 +1,108 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "FrameArena.h"
+
+#pragma warning(push, 0)
+#include <algorithm>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+RenderStudioFrameArena::RenderStudioFrameArena()
+    : mUpstream(std::pmr::new_delete_resource())
+    , mUsage(nullptr)
+{
+    _Resize(kInitialSize);
+}
+
+void
+RenderStudioFrameArena::Reset()
+{
+    // Heap chunks are returned here
+    std::size_t overflow = mUpstream.GetBytes();
+    mPeakUsage = std::max(mPeakUsage, mUsage.GetBytes());
+    mUpdates += 1;
+    mResource.reset();
+
+    if (overflow > 0 && mSize < kMaxSize)
+    {
+        // Update which didn't fit into the buffer makes it bigger for the next ones
+        _Resize(std::min(mSize + overflow, kMaxSize));
+    }
+    else if (mUpdates >= kShrinkAfterUpdates && mPeakUsage * 2 < mSize / 2 && mSize > kInitialSize)
+    {
+        // Large update is over, buffer goes back to twice of what recent updates needed
+        _Resize(std::max(mPeakUsage * 2, kInitialSize));
+    }
+    else
+    {
+        if (mUpdates >= kShrinkAfterUpdates)
+        {
+            mPeakUsage = 0;
+            mUpdates = 0;
+        }
+
+        mResource.emplace(mBuffer.get(), mSize, &mUpstream);
+        mUsage.SetTarget(&*mResource);
+    }
+
+    mUpstream.ResetCounters();
+    mUsage.ResetCounters();
+}
+
+void
+RenderStudioFrameArena::_Resize(std::size_t size)
+{
+    mResource.reset();
+
+    // Not make_unique, it would zero the bytes
+    mBuffer.reset();
+    mBuffer = std::unique_ptr<std::byte[]>(new std::byte[size]);
+    mSize = size;
+    mPeakUsage = 0;
+    mUpdates = 0;
+
+    mResource.emplace(mBuffer.get(), mSize, &mUpstream);
+    mUsage.SetTarget(&*mResource);
+}
+
+void
+RenderStudioFrameArena::_CountingResource::ResetCounters()
+{
+    mBytes = 0;
+    mAllocations = 0;
+}
+
+void*
+RenderStudioFrameArena::_CountingResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    mBytes += bytes;
+    mAllocations += 1;
+    return mTarget->allocate(bytes, alignment);
+}
+
+void
+RenderStudioFrameArena::_CountingResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+{
+    mTarget->deallocate(p, bytes, alignment);
+}
+
+bool
+RenderStudioFrameArena::_CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
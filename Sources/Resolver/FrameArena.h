@@ -0,0 +1,88 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+#include <pxr/pxr.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Monotonic memory for tables which live during single live update only.
+/// Deallocation is a no-op, everything is dropped at once on Reset(). Own buffer grows to the largest update seen,
+/// so steady state updates don't touch the heap at all. Growth stops at kMaxSize, and buffer shrinks back once updates
+/// stay small for a while, so single huge update doesn't pin its memory. Not thread safe, it's meant for USD thread.
+class RenderStudioFrameArena
+{
+public:
+    RenderStudioFrameArena();
+
+    std::pmr::memory_resource* GetResource() { return &mUsage; }
+
+    /// Drops all the allocations, must be called when nothing allocated from arena is alive
+    void Reset();
+
+    /// Heap allocations made since last reset, once own buffer was exhausted
+    std::size_t GetHeapAllocations() const { return mUpstream.GetAllocations(); }
+    std::size_t GetHeapBytes() const { return mUpstream.GetBytes(); }
+
+private:
+    // Counts what is requested from underlying resource
+    class _CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit _CountingResource(std::pmr::memory_resource* target) : mTarget(target) { }
+
+        void SetTarget(std::pmr::memory_resource* target) { mTarget = target; }
+        std::size_t GetBytes() const { return mBytes; }
+        std::size_t GetAllocations() const { return mAllocations; }
+        void ResetCounters();
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        std::pmr::memory_resource* mTarget = nullptr;
+        std::size_t mBytes = 0;
+        std::size_t mAllocations = 0;
+    };
+
+    void _Resize(std::size_t size);
+
+    static constexpr std::size_t kInitialSize = 64 * 1024;
+    static constexpr std::size_t kMaxSize = 64 * 1024 * 1024;
+    static constexpr std::size_t kShrinkAfterUpdates = 256;
+
+    // Bytes are left uninitialized, tables write them before reading
+    std::unique_ptr<std::byte[]> mBuffer;
+    std::size_t mSize = 0;
+
+    // Largest update seen since last resize, and number of updates since then
+    std::size_t mPeakUsage = 0;
+    std::size_t mUpdates = 0;
+
+    // Heap behind own buffer, and front which tables allocate from
+    _CountingResource mUpstream;
+    std::optional<std::pmr::monotonic_buffer_resource> mResource;
+    _CountingResource mUsage;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,130 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Journal.h"
+
+#pragma warning(push, 0)
+#include <fstream>
+#include <iterator>
+
+#include <pxr/base/tf/hash.h>
+#pragma warning(pop)
+
+#include <Logger/Logger.h>
+#include <Utils/FileUtils.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+RenderStudioJournal::RenderStudioJournal()
+{
+    // Journal is optional, edits are still sent if connection comes back before exit
+    try
+    {
+        mRoot = RenderStudio::Utils::GetRenderStudioPath() / "Journal";
+        std::filesystem::create_directories(mRoot);
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_WARNING << "Offline journal disabled: " << ex.what();
+        mRoot.clear();
+    }
+}
+
+void
+RenderStudioJournal::Write(const RenderStudio::API::DeltaEvent& delta) const
+{
+    if (mRoot.empty())
+    {
+        return;
+    }
+
+    std::filesystem::path path = _GetPath(delta.layer);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    try
+    {
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file << boost::json::serialize(boost::json::value_from(delta));
+            if (!file)
+            {
+                throw std::runtime_error("Can't write " + temporary.string());
+            }
+        }
+
+        std::filesystem::rename(temporary, path);
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_WARNING << "Can't journal offline edits of " << delta.layer << ": " << ex.what();
+    }
+}
+
+std::optional<RenderStudio::API::DeltaEvent>
+RenderStudioJournal::Read(const std::string& layer) const
+{
+    if (mRoot.empty())
+    {
+        return {};
+    }
+
+    std::filesystem::path path = _GetPath(layer);
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return {};
+    }
+
+    try
+    {
+        std::string content { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        RenderStudio::API::DeltaEvent delta
+            = boost::json::value_to<RenderStudio::API::DeltaEvent>(boost::json::parse(content));
+
+        // Different layers might share hash
+        if (delta.layer != layer)
+        {
+            return {};
+        }
+
+        return delta;
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_WARNING << "Can't read offline journal " << path.string() << ": " << ex.what();
+        return {};
+    }
+}
+
+void
+RenderStudioJournal::Remove(const std::string& layer) const
+{
+    if (mRoot.empty())
+    {
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::remove(_GetPath(layer), error);
+}
+
+std::filesystem::path
+RenderStudioJournal::_GetPath(const std::string& layer) const
+{
+    // Identifiers are urls, they can't be used as file names
+    return mRoot / (std::to_string(TfHash {}(layer)) + ".json");
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,47 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include <pxr/pxr.h>
+#pragma warning(pop)
+
+#include <Serialization/Api.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// On-disk copy of local edits made while live session is disconnected, single file per layer.
+/// RenderStudioData already keeps only latest value of each edited field, so file holds one compacted delta,
+/// which is rewritten as a whole. Write goes to temporary file first, crash never leaves journal half written.
+class RenderStudioJournal
+{
+public:
+    RenderStudioJournal();
+
+    void Write(const RenderStudio::API::DeltaEvent& delta) const;
+    std::optional<RenderStudio::API::DeltaEvent> Read(const std::string& layer) const;
+    void Remove(const std::string& layer) const;
+
+private:
+    std::filesystem::path _GetPath(const std::string& layer) const;
+
+    std::filesystem::path mRoot;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -16,7 +16,7 @@
 
 #pragma warning(push, 0)
 
-#include <experimental/map>
+#include <experimental/unordered_map>
 
 #pragma warning(pop)
 
@@ -28,6 +28,9 @@ void
 RenderStudioLayerRegistry::AddLayer(SdfLayerHandle layer)
 {
     mCreatedLayers[layer->GetIdentifier()] = layer;
+
+    // First live update of the layer might have journaled edits to restore
+    mDirtyLayers.insert(layer->GetIdentifier());
 }
 
 void
@@ -39,6 +42,7 @@ RenderStudioLayerRegistry::RemoveLayer(SdfLayerHandle layer)
     }
 
     mCreatedLayers.erase(layer->GetIdentifier());
+    mDirtyLayers.erase(layer->GetIdentifier());
 }
 
 void
@@ -46,6 +50,7 @@ RenderStudioLayerRegistry::RemoveExpiredLayers()
 {
     std::experimental::erase_if(mCreatedLayers, [](const auto& pair) { return pair.second.IsExpired(); });
 }
+
 void
 RenderStudioLayerRegistry::ForEachLayer(const std::function<void(SdfLayerHandle)>& fn)
 {
@@ -63,9 +68,10 @@ RenderStudioLayerRegistry::ForEachLayer(const std::function<void(SdfLayerHandle)
 SdfLayerHandle
 RenderStudioLayerRegistry::GetByIdentifier(const std::string& identifier)
 {
-    if (mCreatedLayers.count(identifier))
+    auto it = mCreatedLayers.find(identifier);
+    if (it != mCreatedLayers.end())
     {
-        return mCreatedLayers[identifier];
+        return it->second;
     }
     else
     {
@@ -73,4 +79,34 @@ RenderStudioLayerRegistry::GetByIdentifier(const std::string& identifier)
     }
 }
 
+void
+RenderStudioLayerRegistry::MarkDirty(const std::string& identifier)
+{
+    mDirtyLayers.insert(identifier);
+}
+
+void
+RenderStudioLayerRegistry::ForEachDirtyLayer(const std::function<void(SdfLayerHandle)>& fn)
+{
+    std::unordered_set<std::string> dirty;
+    dirty.swap(mDirtyLayers);
+
+    for (const std::string& identifier : dirty)
+    {
+        auto it = mCreatedLayers.find(identifier);
+        if (it == mCreatedLayers.end())
+        {
+            continue;
+        }
+
+        if (it->second.IsExpired())
+        {
+            mCreatedLayers.erase(it);
+            continue;
+        }
+
+        fn(it->second);
+    }
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
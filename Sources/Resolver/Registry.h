@@ -15,11 +15,18 @@
 #pragma once
 
 #pragma warning(push, 0)
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <pxr/usd/sdf/layer.h>
 #pragma warning(pop)
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+/// Live layers by identifier. Not thread safe, it's used from USD thread only.
+/// Layers with pending work are marked dirty, so live update doesn't visit layers without traffic.
 class RenderStudioLayerRegistry
 {
 public:
@@ -29,8 +36,16 @@ public:
     void ForEachLayer(const std::function<void(SdfLayerHandle)>& fn);
     SdfLayerHandle GetByIdentifier(const std::string& identifier);
 
+    /// Layer is visited by next ForEachDirtyLayer call
+    void MarkDirty(const std::string& identifier);
+
+    /// Visits layers marked since previous call and clears marks, callback might mark layer again.
+    /// Expired layers are dropped on the way
+    void ForEachDirtyLayer(const std::function<void(SdfLayerHandle)>& fn);
+
 private:
-    std::map<std::string, SdfLayerHandle> mCreatedLayers;
+    std::unordered_map<std::string, SdfLayerHandle> mCreatedLayers;
+    std::unordered_set<std::string> mDirtyLayers;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -141,6 +141,26 @@ RenderStudioResolver::ProcessLiveUpdates()
     return sFileFormat->ProcessLiveUpdates();
 }
 
+bool
+RenderStudioResolver::ProcessLiveUpdates(
+    std::chrono::microseconds budget,
+    RenderStudio::Kit::LiveSessionUpdateResult* result)
+{
+    return sFileFormat->ProcessLiveUpdates(std::chrono::steady_clock::now() + budget, result);
+}
+
+bool
+RenderStudioResolver::WaitForLiveUpdate(std::chrono::milliseconds timeout)
+{
+    return sFileFormat->WaitForWork(timeout);
+}
+
+void
+RenderStudioResolver::SetLiveUpdateCallback(std::function<void()> callback)
+{
+    sFileFormat->SetWorkCallback(std::move(callback));
+}
+
 void
 RenderStudioResolver::StartLiveMode(const RenderStudio::Kit::LiveSessionInfo& info)
 {
@@ -169,6 +189,18 @@ RenderStudioResolver::StopLiveMode()
     sFileFormat->Disconnect();
 }
 
+std::vector<RenderStudio::Kit::LiveSessionLayerStats>
+RenderStudioResolver::GetLiveStats()
+{
+    return sFileFormat->GetLiveStats();
+}
+
+std::size_t
+RenderStudioResolver::GetLiveBacklog()
+{
+    return sFileFormat->GetBacklogDepth();
+}
+
 ArResolvedPath
 RenderStudioResolver::_Resolve(const std::string& path) const
 {
@@ -15,7 +15,9 @@
 #pragma once
 
 #pragma warning(push, 0)
+#include <chrono>
 #include <filesystem>
+#include <functional>
 
 #include <pxr/pxr.h>
 #include <pxr/usd/ar/api.h>
@@ -28,6 +30,8 @@
 namespace RenderStudio::Kit
 {
 struct LiveSessionInfo;
+struct LiveSessionLayerStats;
+struct LiveSessionUpdateResult;
 }
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -47,9 +51,24 @@ public:
     AR_API
     static bool ProcessLiveUpdates();
 
+    AR_API
+    static bool ProcessLiveUpdates(std::chrono::microseconds budget, RenderStudio::Kit::LiveSessionUpdateResult* result);
+
+    AR_API
+    static bool WaitForLiveUpdate(std::chrono::milliseconds timeout);
+
+    AR_API
+    static void SetLiveUpdateCallback(std::function<void()> callback);
+
     AR_API
     static void StopLiveMode();
 
+    AR_API
+    static std::vector<RenderStudio::Kit::LiveSessionLayerStats> GetLiveStats();
+
+    AR_API
+    static std::size_t GetLiveBacklog();
+
     AR_API
     static std::string GetLocalStorageUrl();
 
@@ -0,0 +1,252 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Snapshot.h"
+
+#pragma warning(push, 0)
+#include <algorithm>
+
+#include <pxr/usd/sdf/data.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+bool
+RenderStudioDataSnapshot::HasSpec(const SdfPath& path) const
+{
+    return _FindSpec(path) != nullptr;
+}
+
+SdfSpecType
+RenderStudioDataSnapshot::GetSpecType(const SdfPath& path) const
+{
+    const Spec* spec = _FindSpec(path);
+    return spec ? spec->specType : SdfSpecTypeUnknown;
+}
+
+bool
+RenderStudioDataSnapshot::Has(const SdfPath& path, const TfToken& field, VtValue* value) const
+{
+    const Spec* spec = _FindSpec(path);
+    if (spec == nullptr)
+    {
+        return false;
+    }
+
+    const VtValue* fieldValue = field == SdfDataTokens->TimeSamples && !spec->timeSamples.IsEmpty()
+        ? &spec->timeSamples
+        : spec->fields.Find(field);
+    if (fieldValue == nullptr)
+    {
+        return false;
+    }
+
+    if (value)
+    {
+        *value = *fieldValue;
+    }
+
+    return true;
+}
+
+VtValue
+RenderStudioDataSnapshot::Get(const SdfPath& path, const TfToken& field) const
+{
+    VtValue value;
+    Has(path, field, &value);
+    return value;
+}
+
+std::vector<TfToken>
+RenderStudioDataSnapshot::List(const SdfPath& path) const
+{
+    const Spec* spec = _FindSpec(path);
+    if (spec == nullptr)
+    {
+        return {};
+    }
+
+    std::vector<TfToken> fields = spec->fields.GetKeys();
+    if (!spec->timeSamples.IsEmpty())
+    {
+        fields.push_back(SdfDataTokens->TimeSamples);
+    }
+    return fields;
+}
+
+void
+RenderStudioDataSnapshot::ForEachSpec(const std::function<void(const SdfPath&, const Spec&)>& fn) const
+{
+    for (const std::shared_ptr<const _Branch>& branch : mRoot.children)
+    {
+        if (branch == nullptr)
+        {
+            continue;
+        }
+
+        for (const std::shared_ptr<const _Twig>& twig : branch->children)
+        {
+            if (twig == nullptr)
+            {
+                continue;
+            }
+
+            for (const std::shared_ptr<const _Leaf>& leaf : twig->children)
+            {
+                if (leaf == nullptr)
+                {
+                    continue;
+                }
+
+                for (const auto& [path, spec] : *leaf)
+                {
+                    fn(path, *spec);
+                }
+            }
+        }
+    }
+}
+
+std::uint64_t
+RenderStudioDataSnapshot::_GetHash(const SdfPath& path)
+{
+    // Fibonacci hash spreads path hash bits, levels take index from the top bits down
+    return static_cast<std::uint64_t>(SdfPath::Hash {}(path)) * 11400714819323198485ull;
+}
+
+std::size_t
+RenderStudioDataSnapshot::_GetIndex(std::uint64_t hash, std::size_t level)
+{
+    return static_cast<std::size_t>(hash >> (64 - kFanoutBits * (level + 1))) & (kFanout - 1);
+}
+
+const RenderStudioDataSnapshot::_Leaf*
+RenderStudioDataSnapshot::_FindLeaf(const SdfPath& path) const
+{
+    std::uint64_t hash = _GetHash(path);
+
+    const std::shared_ptr<const _Branch>& branch = mRoot.children[_GetIndex(hash, 0)];
+    if (branch == nullptr)
+    {
+        return nullptr;
+    }
+
+    const std::shared_ptr<const _Twig>& twig = branch->children[_GetIndex(hash, 1)];
+    if (twig == nullptr)
+    {
+        return nullptr;
+    }
+
+    return twig->children[_GetIndex(hash, 2)].get();
+}
+
+const RenderStudioDataSnapshot::Spec*
+RenderStudioDataSnapshot::_FindSpec(const SdfPath& path) const
+{
+    const _Leaf* leaf = _FindLeaf(path);
+    if (leaf == nullptr)
+    {
+        return nullptr;
+    }
+
+    for (const auto& [key, spec] : *leaf)
+    {
+        if (key == path)
+        {
+            return spec.get();
+        }
+    }
+
+    return nullptr;
+}
+
+RenderStudioDataSnapshot::Builder::Builder(const std::shared_ptr<const RenderStudioDataSnapshot>& previous)
+    : mSnapshot(previous ? std::make_shared<RenderStudioDataSnapshot>(*previous)
+                         : std::make_shared<RenderStudioDataSnapshot>())
+{
+}
+
+void
+RenderStudioDataSnapshot::Builder::SetSpec(const SdfPath& path, SpecPtr spec)
+{
+    _Leaf& leaf = _GetMutableLeaf(path);
+
+    for (auto& [key, value] : leaf)
+    {
+        if (key == path)
+        {
+            value = std::move(spec);
+            return;
+        }
+    }
+
+    leaf.emplace_back(path, std::move(spec));
+}
+
+void
+RenderStudioDataSnapshot::Builder::EraseSpec(const SdfPath& path)
+{
+    // Don't copy nodes on the way to spec which isn't there
+    if (mSnapshot->_FindSpec(path) == nullptr)
+    {
+        return;
+    }
+
+    _Leaf& leaf = _GetMutableLeaf(path);
+    auto it = std::find_if(leaf.begin(), leaf.end(), [&path](const auto& entry) { return entry.first == path; });
+
+    // Order within leaf doesn't matter
+    std::swap(*it, leaf.back());
+    leaf.pop_back();
+}
+
+std::shared_ptr<const RenderStudioDataSnapshot>
+RenderStudioDataSnapshot::Builder::Build(std::size_t sequence)
+{
+    mSnapshot->mSequence = sequence;
+    mCopiedNodes.clear();
+    return std::move(mSnapshot);
+}
+
+RenderStudioDataSnapshot::_Leaf&
+RenderStudioDataSnapshot::Builder::_GetMutableLeaf(const SdfPath& path)
+{
+    std::uint64_t hash = _GetHash(path);
+
+    _Branch& branch = _MakeMutable(mSnapshot->mRoot.children[_GetIndex(hash, 0)]);
+    _Twig& twig = _MakeMutable(branch.children[_GetIndex(hash, 1)]);
+    return _MakeMutable(twig.children[_GetIndex(hash, 2)]);
+}
+
+template <typename T>
+T&
+RenderStudioDataSnapshot::Builder::_MakeMutable(std::shared_ptr<const T>& node)
+{
+    // Copy on first write, readers of previous snapshot still reference original node
+    if (node == nullptr)
+    {
+        node = std::make_shared<T>();
+        mCopiedNodes.insert(node.get());
+    }
+    else if (mCopiedNodes.find(node.get()) == mCopiedNodes.end())
+    {
+        node = std::make_shared<T>(*node);
+        mCopiedNodes.insert(node.get());
+    }
+
+    // Safe, since this copy isn't visible to anyone yet
+    return const_cast<T&>(*node);
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
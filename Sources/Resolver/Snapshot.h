@@ -0,0 +1,127 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <pxr/base/tf/hash.h>
+#include <pxr/base/tf/hashset.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/ar/api.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/types.h>
+#pragma warning(pop)
+
+#include "FieldMap.h"
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Immutable view of RenderStudioData spec table at some applied sequence.
+/// Snapshots are safe to read from any thread while USD thread applies live updates.
+/// Table is a persistent trie over path hash: each next snapshot copies only nodes on the way to touched specs
+/// and shares the rest, so publishing costs are proportional to the number of changed specs.
+/// Field storage is shared with RenderStudioData until the spec is changed there.
+class RenderStudioDataSnapshot
+{
+public:
+    struct Spec
+    {
+        SdfSpecType specType = SdfSpecTypeUnknown;
+        RenderStudioFieldMap fields;
+
+        /// Kept apart from fields, so animated specs still share field storage with RenderStudioData
+        VtValue timeSamples;
+    };
+
+    using SpecPtr = std::shared_ptr<const Spec>;
+
+    AR_API
+    bool HasSpec(const SdfPath& path) const;
+
+    AR_API
+    SdfSpecType GetSpecType(const SdfPath& path) const;
+
+    AR_API
+    bool Has(const SdfPath& path, const TfToken& field, VtValue* value = nullptr) const;
+
+    AR_API
+    VtValue Get(const SdfPath& path, const TfToken& field) const;
+
+    AR_API
+    std::vector<TfToken> List(const SdfPath& path) const;
+
+    AR_API
+    void ForEachSpec(const std::function<void(const SdfPath&, const Spec&)>& fn) const;
+
+    /// Latest remote sequence applied to the layer when snapshot was published
+    AR_API
+    std::size_t GetSequence() const { return mSequence; }
+
+private:
+    // 3 levels of 64 give 262144 leaves, so leaves stay a few entries long up to millions of specs
+    static constexpr std::size_t kFanoutBits = 6;
+    static constexpr std::size_t kFanout = std::size_t(1) << kFanoutBits;
+
+    using _Leaf = std::vector<std::pair<SdfPath, SpecPtr>>;
+
+    template <typename Child> struct _Node
+    {
+        std::array<std::shared_ptr<const Child>, kFanout> children;
+    };
+
+    using _Twig = _Node<_Leaf>;
+    using _Branch = _Node<_Twig>;
+    using _Root = _Node<_Branch>;
+
+public:
+    /// Writer side. Makes next snapshot from previous one, previous snapshot stays untouched.
+    class Builder
+    {
+    public:
+        explicit Builder(const std::shared_ptr<const RenderStudioDataSnapshot>& previous);
+
+        void SetSpec(const SdfPath& path, SpecPtr spec);
+        void EraseSpec(const SdfPath& path);
+        std::shared_ptr<const RenderStudioDataSnapshot> Build(std::size_t sequence);
+
+    private:
+        _Leaf& _GetMutableLeaf(const SdfPath& path);
+        template <typename T> T& _MakeMutable(std::shared_ptr<const T>& node);
+
+        std::shared_ptr<RenderStudioDataSnapshot> mSnapshot;
+
+        // Nodes copied by this builder, they aren't visible to readers yet and can be changed in place
+        TfHashSet<const void*, TfHash> mCopiedNodes;
+    };
+
+private:
+    static std::uint64_t _GetHash(const SdfPath& path);
+    static std::size_t _GetIndex(std::uint64_t hash, std::size_t level);
+    const _Leaf* _FindLeaf(const SdfPath& path) const;
+    const Spec* _FindSpec(const SdfPath& path) const;
+
+    _Root mRoot;
+    std::size_t mSequence = 0;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,206 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Stats.h"
+
+#pragma warning(push, 0)
+#include <pxr/base/tf/type.h>
+#include <pxr/base/vt/dictionary.h>
+#include <pxr/usd/sdf/listOp.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/reference.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace
+{
+
+std::size_t
+_GetSizeof(const std::type_info& type)
+{
+    // TfType lookup takes a lock, while set of held types is small
+    thread_local std::unordered_map<std::type_index, std::size_t> cache;
+
+    auto [it, inserted] = cache.try_emplace(std::type_index(type), 0);
+    if (inserted)
+    {
+        it->second = TfType::Find(type).GetSizeof();
+    }
+
+    return it->second;
+}
+
+template <class T>
+std::size_t
+_GetListOpSize(const SdfListOp<T>& op)
+{
+    std::size_t items = op.GetExplicitItems().size() + op.GetAddedItems().size() + op.GetPrependedItems().size()
+        + op.GetAppendedItems().size() + op.GetDeletedItems().size() + op.GetOrderedItems().size();
+    return sizeof(SdfListOp<T>) + items * sizeof(T);
+}
+
+} // namespace
+
+void
+RenderStudioDataStats::AddSpec(SdfSpecType specType, std::size_t bytes)
+{
+    mTotal.count += 1;
+    mTotal.bytes += bytes;
+    mBySpecType[specType].count += 1;
+    mBySpecType[specType].bytes += bytes;
+}
+
+void
+RenderStudioDataStats::RemoveSpec(SdfSpecType specType, std::size_t bytes)
+{
+    mTotal.count -= 1;
+    mTotal.bytes -= bytes;
+    mBySpecType[specType].count -= 1;
+    mBySpecType[specType].bytes -= bytes;
+}
+
+void
+RenderStudioDataStats::AddValue(SdfSpecType specType, const TfToken& field, const VtValue& value)
+{
+    _Update(specType, field, value, true);
+}
+
+void
+RenderStudioDataStats::RemoveValue(SdfSpecType specType, const TfToken& field, const VtValue& value)
+{
+    _Update(specType, field, value, false);
+}
+
+void
+RenderStudioDataStats::ForEachField(const std::function<void(const TfToken&, const Bucket&)>& fn) const
+{
+    for (const auto& [field, bucket] : mByField)
+    {
+        fn(field, bucket);
+    }
+}
+
+void
+RenderStudioDataStats::ForEachValueType(const std::function<void(const std::string&, const Bucket&)>& fn) const
+{
+    for (const auto& [type, entry] : mByValueType)
+    {
+        fn(entry.name, entry.bucket);
+    }
+}
+
+std::size_t
+RenderStudioDataStats::EstimateSize(const VtValue& value)
+{
+    if (value.IsEmpty())
+    {
+        return 0;
+    }
+
+    std::size_t bytes = sizeof(VtValue);
+
+    if (value.IsArrayValued())
+    {
+        return bytes + value.GetArraySize() * _GetSizeof(value.GetElementTypeid());
+    }
+
+    if (value.IsHolding<std::string>())
+    {
+        return bytes + value.UncheckedGet<std::string>().size();
+    }
+
+    if (value.IsHolding<std::vector<TfToken>>())
+    {
+        return bytes + value.UncheckedGet<std::vector<TfToken>>().size() * sizeof(TfToken);
+    }
+
+    if (value.IsHolding<VtDictionary>())
+    {
+        for (const auto& [key, item] : value.UncheckedGet<VtDictionary>())
+        {
+            bytes += sizeof(VtDictionary::value_type) + key.size() + EstimateSize(item);
+        }
+        return bytes;
+    }
+
+    if (value.IsHolding<SdfTokenListOp>())
+    {
+        return bytes + _GetListOpSize(value.UncheckedGet<SdfTokenListOp>());
+    }
+
+    if (value.IsHolding<SdfPathListOp>())
+    {
+        return bytes + _GetListOpSize(value.UncheckedGet<SdfPathListOp>());
+    }
+
+    if (value.IsHolding<SdfReferenceListOp>())
+    {
+        return bytes + _GetListOpSize(value.UncheckedGet<SdfReferenceListOp>());
+    }
+
+    // Small values are stored inline, bigger ones are allocated separately
+    std::size_t held = _GetSizeof(value.GetTypeid());
+    return held > sizeof(void*) ? bytes + held : bytes;
+}
+
+void
+RenderStudioDataStats::_Update(SdfSpecType specType, const TfToken& field, const VtValue& value, bool add)
+{
+    if (value.IsEmpty())
+    {
+        return;
+    }
+
+    std::size_t bytes = EstimateSize(value);
+    std::size_t& specBytes = mBySpecType[specType].bytes;
+    mTotal.bytes = add ? mTotal.bytes + bytes : mTotal.bytes - bytes;
+    specBytes = add ? specBytes + bytes : specBytes - bytes;
+
+    Bucket& fieldBucket = mByField[field];
+    _Add(fieldBucket, bytes, add);
+    if (fieldBucket.count == 0)
+    {
+        mByField.erase(field);
+    }
+
+    auto [type, inserted] = mByValueType.try_emplace(std::type_index(value.GetTypeid()));
+    if (inserted)
+    {
+        type->second.name = value.GetTypeName();
+    }
+
+    _Add(type->second.bucket, bytes, add);
+    if (type->second.bucket.count == 0)
+    {
+        mByValueType.erase(type);
+    }
+}
+
+void
+RenderStudioDataStats::_Add(Bucket& bucket, std::size_t bytes, bool add)
+{
+    if (add)
+    {
+        bucket.count += 1;
+        bucket.bytes += bytes;
+    }
+    else
+    {
+        bucket.count -= 1;
+        bucket.bytes -= bytes;
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,78 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <array>
+#include <functional>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+#include <pxr/base/tf/hashmap.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/types.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Estimated memory held by specs of a single layer, grouped by spec type, field and held value type.
+/// Counters are updated on every write to the spec table, so reading them never walks the specs.
+/// Sizes are estimates: shared array buffers are counted by every holder and allocator overhead isn't counted.
+class RenderStudioDataStats
+{
+public:
+    struct Bucket
+    {
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+    };
+
+    /// Spec itself, bytes are table entry overhead without field values
+    void AddSpec(SdfSpecType specType, std::size_t bytes);
+    void RemoveSpec(SdfSpecType specType, std::size_t bytes);
+
+    /// Single field value or time sample, empty values aren't counted
+    void AddValue(SdfSpecType specType, const TfToken& field, const VtValue& value);
+    void RemoveValue(SdfSpecType specType, const TfToken& field, const VtValue& value);
+
+    const Bucket& GetTotal() const { return mTotal; }
+    const Bucket& GetSpecType(SdfSpecType specType) const { return mBySpecType[specType]; }
+
+    void ForEachField(const std::function<void(const TfToken&, const Bucket&)>& fn) const;
+    void ForEachValueType(const std::function<void(const std::string&, const Bucket&)>& fn) const;
+
+    static std::size_t EstimateSize(const VtValue& value);
+
+private:
+    struct _TypeBucket
+    {
+        std::string name;
+        Bucket bucket;
+    };
+
+    void _Update(SdfSpecType specType, const TfToken& field, const VtValue& value, bool add);
+
+    static void _Add(Bucket& bucket, std::size_t bytes, bool add);
+
+    Bucket mTotal;
+    std::array<Bucket, SdfNumSpecTypes> mBySpecType;
+    TfHashMap<TfToken, Bucket, TfToken::HashFunctor> mByField;
+    std::unordered_map<std::type_index, _TypeBucket> mByValueType;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
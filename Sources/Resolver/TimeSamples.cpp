@@ -0,0 +1,143 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TimeSamples.h"
+
+#pragma warning(push, 0)
+#include <algorithm>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+RenderStudioTimeSamples::RenderStudioTimeSamples(const SdfTimeSampleMap& samples)
+{
+    mTimes.reserve(samples.size());
+    mValues.reserve(samples.size());
+
+    // Map is already sorted
+    for (const auto& [time, value] : samples)
+    {
+        mTimes.push_back(time);
+        mValues.push_back(value);
+    }
+}
+
+const VtValue*
+RenderStudioTimeSamples::Find(double time) const
+{
+    std::size_t i = _LowerBound(time);
+    return i < mTimes.size() && mTimes[i] == time ? &mValues[i] : nullptr;
+}
+
+bool
+RenderStudioTimeSamples::Set(double time, const VtValue& value)
+{
+    std::size_t i = _LowerBound(time);
+
+    mMap.reset();
+
+    if (i < mTimes.size() && mTimes[i] == time)
+    {
+        mValues[i] = value;
+        return false;
+    }
+
+    // Keys are usually appended at the end, then insert doesn't shift anything
+    mTimes.insert(mTimes.begin() + i, time);
+    mValues.insert(mValues.begin() + i, value);
+    return true;
+}
+
+bool
+RenderStudioTimeSamples::Erase(double time)
+{
+    std::size_t i = _LowerBound(time);
+
+    if (i == mTimes.size() || mTimes[i] != time)
+    {
+        return false;
+    }
+
+    mMap.reset();
+    mTimes.erase(mTimes.begin() + i);
+    mValues.erase(mValues.begin() + i);
+    return true;
+}
+
+bool
+RenderStudioTimeSamples::GetBracketingTimes(double time, double* tLower, double* tUpper) const
+{
+    if (mTimes.empty())
+    {
+        return false;
+    }
+
+    if (time <= mTimes.front())
+    {
+        // Time is at-or-before the first sample.
+        *tLower = *tUpper = mTimes.front();
+    }
+    else if (time >= mTimes.back())
+    {
+        // Time is at-or-after the last sample.
+        *tLower = *tUpper = mTimes.back();
+    }
+    else
+    {
+        std::size_t i = _LowerBound(time);
+        if (mTimes[i] == time)
+        {
+            // Time is exactly on a sample.
+            *tLower = *tUpper = mTimes[i];
+        }
+        else
+        {
+            // Time is in-between samples; return the bracketing times.
+            *tUpper = mTimes[i];
+            *tLower = mTimes[i - 1];
+        }
+    }
+
+    return true;
+}
+
+VtValue
+RenderStudioTimeSamples::GetMapValue() const
+{
+    // Concurrent readers might build the map twice, only one of them is kept
+    std::shared_ptr<const VtValue> map = std::atomic_load(&mMap);
+    if (map != nullptr)
+    {
+        return *map;
+    }
+
+    SdfTimeSampleMap samples;
+    for (std::size_t i = 0; i < mTimes.size(); i++)
+    {
+        samples.emplace_hint(samples.end(), mTimes[i], mValues[i]);
+    }
+
+    // Map doesn't fit into VtValue local storage, so copies of the value share it
+    map = std::make_shared<const VtValue>(VtValue::Take(samples));
+    std::atomic_store(&mMap, map);
+    return *map;
+}
+
+std::size_t
+RenderStudioTimeSamples::_LowerBound(double time) const
+{
+    return std::lower_bound(mTimes.begin(), mTimes.end(), time) - mTimes.begin();
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,67 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <memory>
+#include <vector>
+
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/types.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Time samples of a single attribute, sorted by time.
+/// Times and values are kept in separate contiguous arrays, lookups and bracketing are binary searches over times.
+/// Outside of RenderStudioData samples are still exposed as SdfTimeSampleMap, as SdfDataTokens->TimeSamples requires.
+/// Such map is built once after each change and shared by all reads until the next one.
+class RenderStudioTimeSamples
+{
+public:
+    RenderStudioTimeSamples() = default;
+    explicit RenderStudioTimeSamples(const SdfTimeSampleMap& samples);
+
+    std::size_t size() const { return mTimes.size(); }
+    bool empty() const { return mTimes.empty(); }
+
+    const std::vector<double>& GetTimes() const { return mTimes; }
+    const std::vector<VtValue>& GetValues() const { return mValues; }
+
+    const VtValue* Find(double time) const;
+
+    /// Inserts or overwrites sample in place. Returns true if there was no sample at this time
+    bool Set(double time, const VtValue& value);
+
+    /// Returns false if there was no sample at this time
+    bool Erase(double time);
+
+    bool GetBracketingTimes(double time, double* tLower, double* tUpper) const;
+
+    /// VtValue holding SdfTimeSampleMap. Could be called from multiple reading threads, but not along with writes
+    VtValue GetMapValue() const;
+
+private:
+    std::size_t _LowerBound(double time) const;
+
+    std::vector<double> mTimes;
+    std::vector<VtValue> mValues;
+
+    // Materialized map, dropped on every change
+    mutable std::shared_ptr<const VtValue> mMap;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,141 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ValuePool.h"
+
+#pragma warning(push, 0)
+#include <algorithm>
+#include <iterator>
+
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/base/tf/hash.h>
+#include <pxr/base/vt/dictionary.h>
+#include <pxr/usd/sdf/listOp.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/reference.h>
+#pragma warning(pop)
+
+#include "Stats.h"
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(
+    RENDER_STUDIO_VALUE_POOL_MB,
+    0,
+    "Share identical large field values between specs and layers, keeping up to this many megabytes in the pool");
+
+namespace
+{
+
+// Hashing and lookup cost more than they save on smaller values
+constexpr std::size_t kMinPooledBytes = 1024;
+
+} // namespace
+
+RenderStudioValuePool&
+RenderStudioValuePool::GetInstance()
+{
+    static RenderStudioValuePool instance;
+    return instance;
+}
+
+RenderStudioValuePool::RenderStudioValuePool()
+    : mBudget(static_cast<std::size_t>(std::max(TfGetEnvSetting(RENDER_STUDIO_VALUE_POOL_MB), 0)) * 1024 * 1024)
+{
+}
+
+void
+RenderStudioValuePool::Intern(VtValue& value)
+{
+    if (!IsEnabled() || !_IsPoolable(value))
+    {
+        return;
+    }
+
+    std::size_t bytes = RenderStudioDataStats::EstimateSize(value);
+    if (bytes < kMinPooledBytes)
+    {
+        return;
+    }
+
+    // Hash is computed outside of the lock, it's the expensive part
+    std::size_t hash = _GetHash(value);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto [begin, end] = mIndex.equal_range(hash);
+    for (auto it = begin; it != end; ++it)
+    {
+        _EntryList::iterator entry = it->second;
+        if (entry->value == value)
+        {
+            mEntries.splice(mEntries.begin(), mEntries, entry);
+            value = entry->value;
+            return;
+        }
+    }
+
+    mEntries.push_front(_Entry { hash, bytes, value });
+    mIndex.emplace(hash, mEntries.begin());
+    mBytes += bytes;
+    _Evict();
+}
+
+bool
+RenderStudioValuePool::_IsPoolable(const VtValue& value)
+{
+    return value.IsArrayValued() || value.IsHolding<VtDictionary>() || value.IsHolding<SdfReferenceListOp>()
+        || value.IsHolding<SdfPathListOp>() || value.IsHolding<SdfTokenListOp>();
+}
+
+std::size_t
+RenderStudioValuePool::_GetHash(const VtValue& value)
+{
+    if (!value.IsHolding<VtDictionary>())
+    {
+        return value.GetHash();
+    }
+
+    // Dictionary is ordered by key, so equal dictionaries are hashed in the same order
+    std::size_t hash = 0;
+    for (const auto& [key, item] : value.UncheckedGet<VtDictionary>())
+    {
+        hash = TfHash::Combine(hash, key, _GetHash(item));
+    }
+    return hash;
+}
+
+void
+RenderStudioValuePool::_Evict()
+{
+    while (mBytes > mBudget && !mEntries.empty())
+    {
+        const _Entry& entry = mEntries.back();
+
+        auto [begin, end] = mIndex.equal_range(entry.hash);
+        for (auto it = begin; it != end; ++it)
+        {
+            if (it->second == std::prev(mEntries.end()))
+            {
+                mIndex.erase(it);
+                break;
+            }
+        }
+
+        mBytes -= entry.bytes;
+        mEntries.pop_back();
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
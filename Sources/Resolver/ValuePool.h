@@ -0,0 +1,70 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Process wide pool of large field values keyed by content hash, shared by all layers.
+/// Identical arrays, dictionaries and list ops are stored once, every holder references the same buffer.
+/// Equality checks of shared values stop at comparing buffers, which speeds up applying remote updates.
+/// Pool keeps at most RENDER_STUDIO_VALUE_POOL_MB of values alive, least recently used ones are dropped first.
+/// Dropping value from the pool doesn't break sharing between its holders, only new copies aren't deduplicated.
+class RenderStudioValuePool
+{
+public:
+    static RenderStudioValuePool& GetInstance();
+
+    bool IsEnabled() const { return mBudget > 0; }
+
+    /// Replaces value with pooled one if identical value is there, otherwise adds value to the pool.
+    /// Small values and types which aren't worth sharing are left untouched. Could be called from any thread.
+    void Intern(VtValue& value);
+
+private:
+    RenderStudioValuePool();
+
+    struct _Entry
+    {
+        std::size_t hash;
+        std::size_t bytes;
+        VtValue value;
+    };
+
+    using _EntryList = std::list<_Entry>;
+
+    static bool _IsPoolable(const VtValue& value);
+    static std::size_t _GetHash(const VtValue& value);
+
+    void _Evict();
+
+    std::mutex mMutex;
+    std::size_t mBudget = 0;
+    std::size_t mBytes = 0;
+
+    // Most recently used entries go first
+    _EntryList mEntries;
+    std::unordered_multimap<std::size_t, _EntryList::iterator> mIndex;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -14,6 +14,10 @@
 
 #include "Api.h"
 
+#pragma warning(push, 0)
+#include <map>
+#pragma warning(pop)
+
 #include "Serialization.h"
 
 namespace
@@ -39,6 +43,214 @@ struct Helper
 
 namespace RenderStudio::API
 {
+// --- TimeSampleOp ---
+void
+tag_invoke(const value_from_tag&, value& json, const TimeSampleOp& v)
+{
+    object result;
+    result["time"] = boost::json::value_from(v.time);
+
+    if (!v.value.IsEmpty())
+    {
+        result["value"] = boost::json::value_from(v.value);
+    }
+
+    json = result;
+}
+
+TimeSampleOp
+tag_invoke(const value_to_tag<TimeSampleOp>&, const value& json)
+{
+    const boost::json::object& root = json.as_object();
+    TimeSampleOp result;
+
+    Helper::Extract(root, result.time, "time");
+
+    if (root.if_contains("value"))
+    {
+        result.value = boost::json::value_to<VtValue>(root.at("value"));
+    }
+
+    return result;
+}
+
+// --- ArrayDiff ---
+void
+tag_invoke(const value_from_tag&, value& json, const ArrayDiff& v)
+{
+    object result;
+    result["baseSize"] = boost::json::value_from(v.baseSize);
+    result["baseHash"] = boost::json::value_from(v.baseHash);
+    result["size"] = boost::json::value_from(v.size);
+    result["ranges"] = boost::json::value_from(v.ranges);
+    result["values"] = boost::json::value_from(v.values);
+    json = result;
+}
+
+ArrayDiff
+tag_invoke(const value_to_tag<ArrayDiff>&, const value& json)
+{
+    const boost::json::object& root = json.as_object();
+    ArrayDiff result;
+
+    Helper::Extract(root, result.baseSize, "baseSize");
+    Helper::Extract(root, result.baseHash, "baseHash");
+    Helper::Extract(root, result.size, "size");
+    Helper::Extract(root, result.ranges, "ranges");
+    Helper::Extract(root, result.values, "values");
+
+    return result;
+}
+
+static array
+ArrayDiffsToJson(const std::vector<std::pair<TfToken, ArrayDiff>>& diffs)
+{
+    array result;
+
+    for (const auto& [key, diff] : diffs)
+    {
+        boost::json::object jsonDiff;
+        jsonDiff["key"] = boost::json::value_from(key);
+        jsonDiff["diff"] = boost::json::value_from(diff);
+        result.push_back(jsonDiff);
+    }
+
+    return result;
+}
+
+static std::vector<std::pair<TfToken, ArrayDiff>>
+ArrayDiffsFromJson(const value& json)
+{
+    std::vector<std::pair<TfToken, ArrayDiff>> result;
+
+    for (const auto& jsonDiff : json.as_array())
+    {
+        TfToken key = boost::json::value_to<TfToken>(jsonDiff.at("key"));
+        ArrayDiff diff = boost::json::value_to<ArrayDiff>(jsonDiff.at("diff"));
+        result.push_back({ key, std::move(diff) });
+    }
+
+    return result;
+}
+
+// --- ChildrenOp ---
+void
+tag_invoke(const value_from_tag&, value& json, const ChildrenOp& v)
+{
+    static const std::map<ChildrenOp::Type, std::string> kTypeNames = {
+        { ChildrenOp::Type::Insert, "insert" },
+        { ChildrenOp::Type::Remove, "remove" },
+        { ChildrenOp::Type::Move, "move" },
+    };
+
+    object result;
+    result["field"] = boost::json::value_from(v.field);
+    result["type"] = boost::json::value_from(kTypeNames.at(v.type));
+    result["name"] = boost::json::value_from(v.name);
+
+    if (!v.anchor.IsEmpty())
+    {
+        result["anchor"] = boost::json::value_from(v.anchor);
+    }
+
+    json = result;
+}
+
+ChildrenOp
+tag_invoke(const value_to_tag<ChildrenOp>&, const value& json)
+{
+    static const std::map<std::string, ChildrenOp::Type> kTypes = {
+        { "insert", ChildrenOp::Type::Insert },
+        { "remove", ChildrenOp::Type::Remove },
+        { "move", ChildrenOp::Type::Move },
+    };
+
+    const boost::json::object& root = json.as_object();
+    ChildrenOp result;
+
+    Helper::Extract(root, result.field, "field");
+    Helper::Extract(root, result.name, "name");
+    result.type = kTypes.at(boost::json::value_to<std::string>(root.at("type")));
+
+    if (root.if_contains("anchor"))
+    {
+        result.anchor = boost::json::value_to<TfToken>(root.at("anchor"));
+    }
+
+    return result;
+}
+
+// --- DictionaryOp ---
+void
+tag_invoke(const value_from_tag&, value& json, const DictionaryOp& v)
+{
+    object result;
+    result["field"] = boost::json::value_from(v.field);
+    result["key"] = boost::json::value_from(v.key);
+
+    if (!v.value.IsEmpty())
+    {
+        result["value"] = boost::json::value_from(v.value);
+    }
+
+    json = result;
+}
+
+DictionaryOp
+tag_invoke(const value_to_tag<DictionaryOp>&, const value& json)
+{
+    const boost::json::object& root = json.as_object();
+    DictionaryOp result;
+
+    Helper::Extract(root, result.field, "field");
+    Helper::Extract(root, result.key, "key");
+
+    if (root.if_contains("value"))
+    {
+        result.value = boost::json::value_to<VtValue>(root.at("value"));
+    }
+
+    return result;
+}
+
+// --- ListOpEdit ---
+void
+tag_invoke(const value_from_tag&, value& json, const ListOpEdit& v)
+{
+    static const std::map<ListOpEdit::Type, std::string> kTypeNames = {
+        { ListOpEdit::Type::Prepend, "prepend" },
+        { ListOpEdit::Type::Append, "append" },
+        { ListOpEdit::Type::Delete, "delete" },
+        { ListOpEdit::Type::Remove, "remove" },
+    };
+
+    object result;
+    result["field"] = boost::json::value_from(v.field);
+    result["type"] = boost::json::value_from(kTypeNames.at(v.type));
+    result["item"] = boost::json::value_from(v.item);
+    json = result;
+}
+
+ListOpEdit
+tag_invoke(const value_to_tag<ListOpEdit>&, const value& json)
+{
+    static const std::map<std::string, ListOpEdit::Type> kTypes = {
+        { "prepend", ListOpEdit::Type::Prepend },
+        { "append", ListOpEdit::Type::Append },
+        { "delete", ListOpEdit::Type::Delete },
+        { "remove", ListOpEdit::Type::Remove },
+    };
+
+    const boost::json::object& root = json.as_object();
+    ListOpEdit result;
+
+    Helper::Extract(root, result.field, "field");
+    Helper::Extract(root, result.item, "item");
+    result.type = kTypes.at(boost::json::value_to<std::string>(root.at("type")));
+
+    return result;
+}
+
 // --- SpecData ---
 void
 tag_invoke(const value_from_tag&, value& json, const SpecData& v)
@@ -55,25 +267,115 @@ tag_invoke(const value_from_tag&, value& json, const SpecData& v)
         jsonFields.push_back(jsonField);
     }
 
+    if (!v.timeSamples.empty())
+    {
+        result["timeSamples"] = boost::json::value_from(v.timeSamples);
+    }
+
+    if (!v.arrayDiffs.empty())
+    {
+        result["arrayDiffs"] = ArrayDiffsToJson(v.arrayDiffs);
+    }
+
+    if (!v.childrenOps.empty())
+    {
+        result["childrenOps"] = boost::json::value_from(v.childrenOps);
+    }
+
+    if (!v.dictionaryOps.empty())
+    {
+        result["dictionaryOps"] = boost::json::value_from(v.dictionaryOps);
+    }
+
+    if (!v.listOpEdits.empty())
+    {
+        result["listOpEdits"] = boost::json::value_from(v.listOpEdits);
+    }
+
     json = result;
 }
 
 SpecData
 tag_invoke(const value_to_tag<SpecData>&, const value& json)
 {
-    object jsonObject = json.as_object();
-    array jsonFields = jsonObject.at("fields").as_array();
+    const object& jsonObject = json.as_object();
 
     SpecData result;
     result.specType = boost::json::value_to<SdfSpecType>(jsonObject.at("specType"));
 
-    for (const auto& jsonField : jsonFields)
+    for (const auto& jsonField : jsonObject.at("fields").as_array())
     {
         TfToken key = boost::json::value_to<TfToken>(jsonField.at("key"));
         VtValue value = boost::json::value_to<VtValue>(jsonField.at("value"));
-        result.fields.push_back({ key, value });
+        result.fields.emplace_back(std::move(key), std::move(value));
+    }
+
+    if (jsonObject.if_contains("timeSamples"))
+    {
+        result.timeSamples = boost::json::value_to<std::vector<TimeSampleOp>>(jsonObject.at("timeSamples"));
+    }
+
+    if (jsonObject.if_contains("arrayDiffs"))
+    {
+        result.arrayDiffs = ArrayDiffsFromJson(jsonObject.at("arrayDiffs"));
+    }
+
+    if (jsonObject.if_contains("childrenOps"))
+    {
+        result.childrenOps = boost::json::value_to<std::vector<ChildrenOp>>(jsonObject.at("childrenOps"));
+    }
+
+    if (jsonObject.if_contains("dictionaryOps"))
+    {
+        result.dictionaryOps = boost::json::value_to<std::vector<DictionaryOp>>(jsonObject.at("dictionaryOps"));
+    }
+
+    if (jsonObject.if_contains("listOpEdits"))
+    {
+        result.listOpEdits = boost::json::value_to<std::vector<ListOpEdit>>(jsonObject.at("listOpEdits"));
+    }
+
+    return result;
+}
+
+// --- NamespaceEdit ---
+void
+tag_invoke(const value_from_tag&, value& json, const NamespaceEdit& v)
+{
+    object result;
+    result["type"] = v.type == NamespaceEdit::Type::Erase ? "erase" : "move";
+    result["path"] = boost::json::value_from(v.path);
+
+    if (v.type == NamespaceEdit::Type::Move)
+    {
+        result["newPath"] = boost::json::value_from(v.newPath);
+    }
+
+    json = result;
+}
+
+NamespaceEdit
+tag_invoke(const value_to_tag<NamespaceEdit>&, const value& json)
+{
+    const boost::json::object& root = json.as_object();
+    NamespaceEdit result;
+
+    std::string type = boost::json::value_to<std::string>(root.at("type"));
+    if (type == "erase")
+    {
+        result.type = NamespaceEdit::Type::Erase;
+    }
+    else if (type == "move")
+    {
+        result.type = NamespaceEdit::Type::Move;
+        Helper::Extract(root, result.newPath, "newPath");
+    }
+    else
+    {
+        throw std::runtime_error("Unknown namespace edit: " + type);
     }
 
+    Helper::Extract(root, result.path, "path");
     return result;
 }
 
@@ -107,9 +409,44 @@ tag_invoke(const value_from_tag&, value& json, const DeltaEvent& v)
             jsonFields.push_back(jsonField);
         }
 
+        if (!spec.timeSamples.empty())
+        {
+            jsonUpdate["timeSamples"] = boost::json::value_from(spec.timeSamples);
+        }
+
+        if (!spec.arrayDiffs.empty())
+        {
+            jsonUpdate["arrayDiffs"] = ArrayDiffsToJson(spec.arrayDiffs);
+        }
+
+        if (!spec.childrenOps.empty())
+        {
+            jsonUpdate["childrenOps"] = boost::json::value_from(spec.childrenOps);
+        }
+
+        if (!spec.dictionaryOps.empty())
+        {
+            jsonUpdate["dictionaryOps"] = boost::json::value_from(spec.dictionaryOps);
+        }
+
+        if (!spec.listOpEdits.empty())
+        {
+            jsonUpdate["listOpEdits"] = boost::json::value_from(spec.listOpEdits);
+        }
+
         jsonUpdates.push_back(jsonUpdate);
     }
 
+    if (!v.namespaceEdits.empty())
+    {
+        result["namespaceEdits"] = boost::json::value_from(v.namespaceEdits);
+    }
+
+    if (v.ephemeral)
+    {
+        result["ephemeral"] = true;
+    }
+
     json = result;
 }
 
@@ -123,22 +460,59 @@ tag_invoke(const value_to_tag<DeltaEvent>&, const value& json)
     Helper::Extract(root, result.user, "user");
     Helper::Extract(root, result.sequence, "sequence");
 
-    boost::json::array jsonUpdates = json.at("updates").as_array();
-    TfHashMap<SdfPath, SpecData, SdfPath::Hash> updates;
+    // Values are moved into place, nothing is copied on the way from message to layer
+    const boost::json::array& jsonUpdates = json.at("updates").as_array();
+    result.updates.reserve(jsonUpdates.size());
 
     for (const auto& jsonUpdate : jsonUpdates)
     {
-        SdfPath path = boost::json::value_to<SdfPath>(jsonUpdate.at("path"));
-        boost::json::array jsonFields = jsonUpdate.at("fields").as_array();
+        const boost::json::object& jsonObject = jsonUpdate.as_object();
+        SdfPath path = boost::json::value_to<SdfPath>(jsonObject.at("path"));
+        SpecData& spec = result.updates[path];
 
-        for (const auto& jsonField : jsonFields)
+        for (const auto& jsonField : jsonObject.at("fields").as_array())
         {
             TfToken key = boost::json::value_to<TfToken>(jsonField.at("key"));
             VtValue value = boost::json::value_to<VtValue>(jsonField.at("value"));
-            result.updates[path].fields.push_back({ key, value });
+            spec.fields.emplace_back(std::move(key), std::move(value));
+        }
+
+        spec.specType = boost::json::value_to<SdfSpecType>(jsonObject.at("spec"));
+
+        if (jsonObject.if_contains("timeSamples"))
+        {
+            spec.timeSamples = boost::json::value_to<std::vector<TimeSampleOp>>(jsonObject.at("timeSamples"));
+        }
+
+        if (jsonObject.if_contains("arrayDiffs"))
+        {
+            spec.arrayDiffs = ArrayDiffsFromJson(jsonObject.at("arrayDiffs"));
+        }
+
+        if (jsonObject.if_contains("childrenOps"))
+        {
+            spec.childrenOps = boost::json::value_to<std::vector<ChildrenOp>>(jsonObject.at("childrenOps"));
+        }
+
+        if (jsonObject.if_contains("dictionaryOps"))
+        {
+            spec.dictionaryOps = boost::json::value_to<std::vector<DictionaryOp>>(jsonObject.at("dictionaryOps"));
+        }
+
+        if (jsonObject.if_contains("listOpEdits"))
+        {
+            spec.listOpEdits = boost::json::value_to<std::vector<ListOpEdit>>(jsonObject.at("listOpEdits"));
         }
+    }
 
-        result.updates[path].specType = boost::json::value_to<SdfSpecType>(jsonUpdate.at("spec"));
+    if (root.if_contains("namespaceEdits"))
+    {
+        result.namespaceEdits = boost::json::value_to<std::vector<NamespaceEdit>>(root.at("namespaceEdits"));
+    }
+
+    if (root.if_contains("ephemeral"))
+    {
+        result.ephemeral = root.at("ephemeral").as_bool();
     }
 
     return result;
@@ -158,7 +532,7 @@ tag_invoke(const value_from_tag&, value& json, const AcknowledgeEvent& v)
 AcknowledgeEvent
 tag_invoke(const value_to_tag<AcknowledgeEvent>&, const value& json)
 {
-    boost::json::object root = json.as_object();
+    const boost::json::object& root = json.as_object();
     AcknowledgeEvent result;
 
     Helper::Extract(root, result.layer, "layer");
@@ -202,7 +576,7 @@ tag_invoke(const value_from_tag&, value& json, const ReloadEvent& v)
 ReloadEvent
 tag_invoke(const value_to_tag<ReloadEvent>&, const value& json)
 {
-    boost::json::object root = json.as_object();
+    const boost::json::object& root = json.as_object();
     ReloadEvent result;
 
     Helper::Extract(root, result.layer, "layer");
@@ -247,7 +621,7 @@ Event
 tag_invoke(const value_to_tag<Event>&, const value& json)
 {
     Event result;
-    object jsonObject = json.as_object();
+    const object& jsonObject = json.as_object();
     std::string jsonEvent = boost::json::value_to<std::string>(jsonObject.at("event"));
     result.event = jsonEvent;
 
@@ -275,4 +649,13 @@ tag_invoke(const value_to_tag<Event>&, const value& json)
     return result;
 }
 
+std::string
+SerializeDeltaEvent(const DeltaEvent& v)
+{
+    object result;
+    result["event"] = "Delta::Event";
+    result["body"] = boost::json::value_from(v);
+    return boost::json::serialize(result);
+}
+
 } // namespace RenderStudio::API
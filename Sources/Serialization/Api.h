@@ -15,6 +15,9 @@
 #pragma once
 
 #pragma warning(push, 0)
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 #include <pxr/base/tf/declarePtrs.h>
@@ -37,21 +40,140 @@ namespace RenderStudio::API
 PXR_NAMESPACE_USING_DIRECTIVE
 using namespace boost::json;
 
+struct TimeSampleOp
+{
+    double time = 0.0;
+    VtValue value; // Empty value erases sample
+};
+
+void tag_invoke(const value_from_tag&, value& json, const TimeSampleOp& v);
+TimeSampleOp tag_invoke(const value_to_tag<TimeSampleOp>&, const value& json);
+
+struct ArrayDiff
+{
+    std::size_t baseSize = 0;        // Element count of array diff was made against
+    std::uint64_t baseHash = 0;      // Hash of base array bytes, diff is dropped if receiver has other base
+    std::size_t size = 0;            // Element count after applying
+    std::vector<std::size_t> ranges; // Pairs of first changed index and count
+    VtValue values;                  // Changed elements of all ranges, packed into single VtArray
+};
+
+void tag_invoke(const value_from_tag&, value& json, const ArrayDiff& v);
+ArrayDiff tag_invoke(const value_to_tag<ArrayDiff>&, const value& json);
+
+struct ChildrenOp
+{
+    enum class Type
+    {
+        Insert,
+        Remove,
+        Move
+    };
+
+    TfToken field; // primChildren or propertyChildren
+    Type type = Type::Insert;
+    TfToken name;
+    TfToken anchor; // Element to place after, empty means front of the list
+};
+
+void tag_invoke(const value_from_tag&, value& json, const ChildrenOp& v);
+ChildrenOp tag_invoke(const value_to_tag<ChildrenOp>&, const value& json);
+
+struct DictionaryOp
+{
+    TfToken field;
+    std::string key;
+    VtValue value; // Empty value erases key
+};
+
+void tag_invoke(const value_from_tag&, value& json, const DictionaryOp& v);
+DictionaryOp tag_invoke(const value_to_tag<DictionaryOp>&, const value& json);
+
+struct ListOpEdit
+{
+    enum class Type
+    {
+        Prepend, // Front of prepended items
+        Append,  // Back of appended items
+        Delete,  // Back of deleted items
+        Remove   // Out of all item lists
+    };
+
+    TfToken field;
+    Type type = Type::Append;
+    VtValue item; // SdfPath, SdfReference or TfToken, same as list op
+};
+
+void tag_invoke(const value_from_tag&, value& json, const ListOpEdit& v);
+ListOpEdit tag_invoke(const value_to_tag<ListOpEdit>&, const value& json);
+
+// Move only, so field values are never copied on the way between network and layer data
 struct SpecData
 {
+    SpecData() = default;
+    SpecData(SpecData&&) = default;
+    SpecData& operator=(SpecData&&) = default;
+    SpecData(const SpecData&) = delete;
+    SpecData& operator=(const SpecData&) = delete;
+
     SdfSpecType specType = SdfSpecTypeUnknown;
     std::vector<std::pair<TfToken, VtValue>> fields;
+
+    // Single sample edits, applied after fields
+    std::vector<TimeSampleOp> timeSamples;
+
+    // Array fields sent as changed ranges, applied after fields
+    std::vector<std::pair<TfToken, ArrayDiff>> arrayDiffs;
+
+    // Children list edits, applied after fields
+    std::vector<ChildrenOp> childrenOps;
+
+    // Key and item level edits of dictionary and list op fields, applied after fields
+    std::vector<DictionaryOp> dictionaryOps;
+    std::vector<ListOpEdit> listOpEdits;
+
+    bool IsAcknowledge() const
+    {
+        return fields.empty() && timeSamples.empty() && arrayDiffs.empty() && childrenOps.empty()
+            && dictionaryOps.empty() && listOpEdits.empty();
+    }
 };
 
 void tag_invoke(const value_from_tag&, value& json, const SpecData& v);
 SpecData tag_invoke(const value_to_tag<SpecData>&, const value& json);
 
+struct NamespaceEdit
+{
+    enum class Type
+    {
+        Erase,
+        Move
+    };
+
+    Type type = Type::Erase;
+    SdfPath path;    // Root of erased or moved subtree
+    SdfPath newPath; // Only for move
+};
+
+void tag_invoke(const value_from_tag&, value& json, const NamespaceEdit& v);
+NamespaceEdit tag_invoke(const value_to_tag<NamespaceEdit>&, const value& json);
+
+// Shared by network messages and RenderStudioData. TfHashMap might be copy only, std::unordered_map always moves
+using DeltaTable = std::unordered_map<SdfPath, SpecData, SdfPath::Hash>;
+
 struct DeltaEvent
 {
     std::string layer;
     std::string user;
     std::optional<std::size_t> sequence;
-    TfHashMap<SdfPath, SpecData, SdfPath::Hash> updates;
+    DeltaTable updates;
+
+    // Whole subtree erases and moves, applied in order before updates
+    std::vector<NamespaceEdit> namespaceEdits;
+
+    // Interactive values, relayed by server without sequence and never stored in history.
+    // Final value is always sent afterwards as regular delta
+    bool ephemeral = false;
 };
 
 void tag_invoke(const value_from_tag&, value& json, const DeltaEvent& v);
@@ -93,4 +215,7 @@ struct Event
 void tag_invoke(const value_from_tag&, value& json, const Event& v);
 Event tag_invoke(const value_to_tag<Event>&, const value& json);
 
+// Same message as Event with DeltaEvent body, for deltas which stay where they are stored
+std::string SerializeDeltaEvent(const DeltaEvent& v);
+
 } // namespace RenderStudio::API
@@ -224,6 +224,14 @@ tag_invoke(const value_from_tag&, value& json, const VtValue& v)
     {
         data = value_from(v.Get<SdfValueBlock>());
     }
+    else if (v.IsHolding<SdfPath>())
+    {
+        data = value_from(v.Get<SdfPath>());
+    }
+    else if (v.IsHolding<SdfReference>())
+    {
+        data = value_from(v.Get<SdfReference>());
+    }
     else
     {
         throw std::runtime_error("Can't serialize type: " + v.GetTypeName());
@@ -335,6 +343,14 @@ tag_invoke(const value_to_tag<VtValue>&, const value& json)
     {
         return VtValue { value_to<SdfValueBlock>(data) };
     }
+    else if ("SdfPath" == type)
+    {
+        return VtValue { value_to<SdfPath>(data) };
+    }
+    else if ("SdfReference" == type)
+    {
+        return VtValue { value_to<SdfReference>(data) };
+    }
     else
     {
         throw std::runtime_error("Can't parse type: " + type);
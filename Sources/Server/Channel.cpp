@@ -62,14 +62,9 @@ Channel::GetConnections() const
 }
 
 void
-Channel::AddToHistory(const RenderStudio::API::DeltaEvent& v)
+Channel::AddToHistory(RenderStudio::API::DeltaEvent v)
 {
-    if (mHistory.find(v.layer) == mHistory.end())
-    {
-        mHistory.insert({ v.layer, {} });
-    }
-
-    mHistory.at(v.layer).push_back(v);
+    mHistory[v.layer].push_back(std::move(v));
 }
 
 void
@@ -33,7 +33,7 @@ public:
     void Send(ConnectionPtr connection, const std::string& message);
     const std::map<std::string, std::vector<RenderStudio::API::DeltaEvent>>& GetHistory() const;
     const std::list<ConnectionPtr>& GetConnections() const;
-    void AddToHistory(const RenderStudio::API::DeltaEvent& v);
+    void AddToHistory(RenderStudio::API::DeltaEvent v);
     void ClearHistory(const std::string& layer);
     bool Empty() const;
     std::size_t GetSequenceNumber(const std::string& layer) const;
@@ -40,8 +40,7 @@ Logic::OnConnected(ConnectionPtr connection)
     {
         for (const auto& delta : deltas)
         {
-            RenderStudio::API::Event event { "Delta::Event", delta };
-            connection->Send(boost::json::serialize(boost::json::value_from(event)));
+            connection->Send(RenderStudio::API::SerializeDeltaEvent(delta));
         }
     }
 
@@ -91,7 +90,7 @@ Logic::OnMessage(ConnectionPtr connection, const std::string& message)
 
     std::visit(
         Overload {
-            [&connection, this, &message](const RenderStudio::API::DeltaEvent& v)
+            [&connection, this, &message](RenderStudio::API::DeltaEvent& v)
             {
                 // Thread safety
                 std::lock_guard<std::mutex> lock(mMutex);
@@ -103,20 +102,19 @@ Logic::OnMessage(ConnectionPtr connection, const std::string& message)
                     return;
                 }
 
-                // Process sequence
+                // Interactive values are only relayed, final value comes later as regular delta
                 Channel& channel = mChannels.at(connection->GetChannel());
-                std::size_t sequence = channel.GetSequenceNumber(v.layer);
-                RenderStudio::API::DeltaEvent acknowledgedDelta = v;
-                acknowledgedDelta.sequence = sequence;
+                if (v.ephemeral)
+                {
+                    channel.Send(connection, RenderStudio::API::SerializeDeltaEvent(v));
+                    return;
+                }
 
-                // Broadcast update to users
-                channel.AddToHistory(acknowledgedDelta);
-                channel.Send(
-                    connection,
-                    boost::json::serialize(
-                        boost::json::value_from(RenderStudio::API::Event { "Delta::Event", acknowledgedDelta })));
+                // Process sequence
+                std::size_t sequence = channel.GetSequenceNumber(v.layer);
+                std::string layer = v.layer;
 
-                // Send acknowledge
+                // Collect acknowledged paths before delta is moved to history
                 std::vector<pxr::SdfPath> paths;
 
                 for (const auto& [key, value] : v.updates)
@@ -124,8 +122,19 @@ Logic::OnMessage(ConnectionPtr connection, const std::string& message)
                     paths.push_back(key);
                 }
 
+                for (const RenderStudio::API::NamespaceEdit& edit : v.namespaceEdits)
+                {
+                    paths.push_back(edit.path);
+                }
+
+                // Broadcast update to users, delta itself is moved, not copied
+                v.sequence = sequence;
+                channel.Send(connection, RenderStudio::API::SerializeDeltaEvent(v));
+                channel.AddToHistory(std::move(v));
+
+                // Send acknowledge
                 RenderStudio::API::Event ack { "Acknowledge::Event",
-                                               RenderStudio::API::AcknowledgeEvent { v.layer, paths, sequence } };
+                                               RenderStudio::API::AcknowledgeEvent { layer, paths, sequence } };
                 connection->Send(boost::json::serialize(boost::json::value_from(ack)));
             },
             [](const RenderStudio::API::HistoryEvent& v)
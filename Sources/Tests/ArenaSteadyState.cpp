@@ -0,0 +1,117 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LiveSession.h"
+#include "Tests.h"
+
+#pragma warning(push, 0)
+#include <chrono>
+#include <iostream>
+
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/schema.h>
+#pragma warning(pop)
+
+#include <Serialization/Api.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace
+{
+
+constexpr std::size_t kDefaultPrimCount = 5000;
+constexpr std::size_t kWarmUpUpdates = 3;
+constexpr std::size_t kMeasuredUpdates = 10;
+
+SdfLayerRefPtr
+_CreatePrims(std::size_t primCount)
+{
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous("ArenaSteadyState.usda");
+    SdfChangeBlock block;
+
+    SdfPrimSpecHandle world = SdfPrimSpec::New(layer, "World", SdfSpecifierDef, "Xform");
+    for (std::size_t i = 0; i < primCount; i++)
+    {
+        SdfPrimSpecHandle prim = SdfPrimSpec::New(world, TfStringPrintf("Prim_%zu", i), SdfSpecifierDef, "Xform");
+        SdfAttributeSpecHandle attribute = SdfAttributeSpec::New(prim, "size", SdfValueTypeNames->Float);
+        attribute->SetDefaultValue(VtValue(0.0f));
+    }
+
+    return layer;
+}
+
+// Other user writes size of every prim, so each update has the same shape
+std::string
+_CreateMessage(const SdfLayerRefPtr& layer, std::size_t primCount, std::size_t sequence)
+{
+    RenderStudio::API::DeltaEvent delta;
+    delta.layer = layer->GetIdentifier();
+    delta.user = "RenderStudioTests";
+    delta.sequence = sequence;
+
+    for (std::size_t i = 0; i < primCount; i++)
+    {
+        RenderStudio::API::SpecData& spec = delta.updates[SdfPath(TfStringPrintf("/World/Prim_%zu.size", i))];
+        spec.specType = SdfSpecTypeAttribute;
+        spec.fields.emplace_back(SdfFieldKeys->Default, VtValue(static_cast<float>(sequence)));
+    }
+
+    return RenderStudio::API::SerializeDeltaEvent(delta);
+}
+
+} // namespace
+
+namespace RenderStudio::Tests
+{
+
+bool
+ArenaSteadyState(const std::vector<std::string>& args)
+{
+    std::size_t primCount = args.empty() ? kDefaultPrimCount : std::stoul(args.front());
+
+    PrepareWorkspace("ArenaSteadyState");
+    SdfLayerRefPtr layer = OpenLiveLayer(_CreatePrims(primCount), "ArenaSteadyState.usda");
+
+    bool result = true;
+    std::size_t sequence = 0;
+
+    for (std::size_t i = 0; i < kWarmUpUpdates + kMeasuredUpdates; i++)
+    {
+        DeliverMessage(_CreateMessage(layer, primCount, ++sequence));
+        TEST_CHECK(Kit::LiveSessionWaitForUpdate(std::chrono::seconds(10)), result);
+
+        Kit::LiveSessionUpdateResult update = Kit::LiveSessionUpdate(std::chrono::seconds(10));
+        TEST_CHECK(update.updated, result);
+        TEST_CHECK(update.remaining == 0, result);
+
+        std::cout << "Update " << sequence << " made " << update.arenaHeapAllocations << " arena heap allocations, "
+                  << update.arenaHeapBytes << " bytes" << std::endl;
+
+        // Buffer has grown to the size of this update during warm-up, no heap is touched after that
+        if (i >= kWarmUpUpdates)
+        {
+            TEST_CHECK(update.arenaHeapAllocations == 0, result);
+        }
+    }
+
+    SdfPath last(TfStringPrintf("/World/Prim_%zu.size", primCount - 1));
+    TEST_CHECK(layer->GetField(last, SdfFieldKeys->Default) == VtValue(static_cast<float>(sequence)), result);
+
+    return result;
+}
+
+} // namespace RenderStudio::Tests
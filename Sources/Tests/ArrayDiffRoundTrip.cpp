@@ -0,0 +1,192 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Tests.h"
+
+#pragma warning(push, 0)
+#include <limits>
+#include <numeric>
+
+#include <pxr/base/vt/array.h>
+#pragma warning(pop)
+
+#include <Resolver/ArrayDiff.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace
+{
+
+// Array of block multiple size, so block edges are at known indices
+constexpr std::size_t kSize = 1024;
+
+VtIntArray
+_MakeBase()
+{
+    VtIntArray array(kSize);
+    std::iota(array.begin(), array.end(), 0);
+    return array;
+}
+
+// Diff must exist and reproduce value from base, ranges are checked when given
+bool
+_RoundTrip(const VtIntArray& base, const VtIntArray& value, const std::vector<std::size_t>* ranges = nullptr)
+{
+    std::optional<RenderStudio::API::ArrayDiff> diff = RenderStudioArrayDiff::Compute(VtValue(base), VtValue(value));
+    if (!diff.has_value())
+    {
+        LOG_ERROR << "No diff for " << base.size() << " -> " << value.size() << " elements";
+        return false;
+    }
+
+    if (ranges && diff->ranges != *ranges)
+    {
+        LOG_ERROR << "Unexpected ranges of " << base.size() << " -> " << value.size() << " elements diff";
+        return false;
+    }
+
+    VtValue result;
+    return RenderStudioArrayDiff::Apply(VtValue(base), *diff, &result) && result == VtValue(value);
+}
+
+// Diff broken by given function must be rejected and leave result untouched
+template <class Fn>
+bool
+_IsRejected(const VtIntArray& base, const RenderStudio::API::ArrayDiff& diff, Fn&& breakDiff)
+{
+    RenderStudio::API::ArrayDiff broken = diff;
+    breakDiff(broken);
+
+    VtValue result;
+    return !RenderStudioArrayDiff::Apply(VtValue(base), broken, &result) && result.IsEmpty();
+}
+
+} // namespace
+
+namespace RenderStudio::Tests
+{
+
+bool
+ArrayDiffRoundTrip(const std::vector<std::string>& args)
+{
+    (void)args;
+
+    bool result = true;
+    const VtIntArray base = _MakeBase();
+
+    // Unchanged array gives empty diff
+    std::vector<std::size_t> ranges;
+    TEST_CHECK(_RoundTrip(base, base, &ranges), result);
+
+    // Range spanning block edge is kept single
+    VtIntArray value = base;
+    value[63] = -1;
+    value[64] = -1;
+    ranges = { 63, 2 };
+    TEST_CHECK(_RoundTrip(base, value, &ranges), result);
+
+    // Range open at the end of block is closed by next block which is equal as a whole
+    value = base;
+    value[127] = -1;
+    ranges = { 127, 1 };
+    TEST_CHECK(_RoundTrip(base, value, &ranges), result);
+
+    // Whole block and first element of the array
+    value = base;
+    std::fill(value.begin(), value.begin() + 64, -1);
+    ranges = { 0, 64 };
+    TEST_CHECK(_RoundTrip(base, value, &ranges), result);
+
+    // Range open at the end of array
+    value = base;
+    value[kSize - 1] = -1;
+    ranges = { kSize - 1, 1 };
+    TEST_CHECK(_RoundTrip(base, value, &ranges), result);
+
+    // Growing array sends only appended elements
+    value = base;
+    for (int i = 0; i < 10; i++)
+    {
+        value.push_back(-i);
+    }
+    ranges = { kSize, 10 };
+    TEST_CHECK(_RoundTrip(base, value, &ranges), result);
+
+    // Range open at the end of base is merged with appended elements
+    value[kSize - 1] = -1;
+    ranges = { kSize - 1, 11 };
+    TEST_CHECK(_RoundTrip(base, value, &ranges), result);
+
+    // Shrinking array sends only the new size
+    value = base;
+    value.resize(1000);
+    ranges = {};
+    TEST_CHECK(_RoundTrip(base, value, &ranges), result);
+
+    value[999] = -1;
+    ranges = { 999, 1 };
+    TEST_CHECK(_RoundTrip(base, value, &ranges), result);
+
+    // Shrinking to nothing
+    TEST_CHECK(_RoundTrip(base, VtIntArray()), result);
+
+    // Full value is cheaper when many elements changed
+    value = base;
+    for (std::size_t i = 0; i < kSize; i += 2)
+    {
+        value[i] = -1;
+    }
+    TEST_CHECK(!RenderStudioArrayDiff::Compute(VtValue(base), VtValue(value)).has_value(), result);
+
+    // Types differ or aren't supported
+    TEST_CHECK(!RenderStudioArrayDiff::Compute(VtValue(base), VtValue(VtFloatArray(kSize))).has_value(), result);
+    TEST_CHECK(!RenderStudioArrayDiff::Compute(VtValue(1), VtValue(2)).has_value(), result);
+
+    // Malformed or mismatching diffs are rejected before base is copied
+    value = base;
+    value[10] = -1;
+    value[500] = -1;
+    value.push_back(-1);
+    std::optional<RenderStudio::API::ArrayDiff> diff = RenderStudioArrayDiff::Compute(VtValue(base), VtValue(value));
+    TEST_CHECK(diff.has_value(), result);
+
+    if (diff.has_value())
+    {
+        using Diff = RenderStudio::API::ArrayDiff;
+        constexpr std::size_t kMax = std::numeric_limits<std::size_t>::max();
+
+        VtIntArray otherBase = base;
+        otherBase[0] = -1;
+        VtValue patched;
+        TEST_CHECK(!RenderStudioArrayDiff::Apply(VtValue(otherBase), *diff, &patched), result);
+        TEST_CHECK(!RenderStudioArrayDiff::Apply(VtValue(VtFloatArray(kSize)), *diff, &patched), result);
+
+        TEST_CHECK(_IsRejected(base, *diff, [](Diff& d) { d.baseSize++; }), result);
+        TEST_CHECK(_IsRejected(base, *diff, [](Diff& d) { d.ranges.pop_back(); }), result);
+        TEST_CHECK(_IsRejected(base, *diff, [](Diff& d) { d.ranges[1]++; }), result);
+        TEST_CHECK(_IsRejected(base, *diff, [](Diff& d) { d.ranges[1]--; }), result);
+        TEST_CHECK(_IsRejected(base, *diff, [](Diff& d) { d.ranges[0] = d.size; }), result);
+        TEST_CHECK(_IsRejected(base, *diff, [](Diff& d) { d.ranges[0] = kMax; }), result);
+        TEST_CHECK(_IsRejected(base, *diff, [](Diff& d) { d.size = kMax; }), result);
+        TEST_CHECK(_IsRejected(base, *diff, [](Diff& d) { d.values = VtValue(VtFloatArray(3)); }), result);
+        TEST_CHECK(_IsRejected(base, *diff, [](Diff& d) { d.values = VtValue(); }), result);
+
+        // Intact diff still applies
+        TEST_CHECK(RenderStudioArrayDiff::Apply(VtValue(base), *diff, &patched) && patched == VtValue(value), result);
+    }
+
+    return result;
+}
+
+} // namespace RenderStudio::Tests
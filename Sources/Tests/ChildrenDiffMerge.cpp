@@ -0,0 +1,193 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Tests.h"
+
+#pragma warning(push, 0)
+#include <algorithm>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/usd/sdf/schema.h>
+#pragma warning(pop)
+
+#include <Resolver/ChildrenDiff.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace
+{
+
+using ChildrenOp = RenderStudio::API::ChildrenOp;
+
+TfTokenVector
+_MakeList(const std::vector<const char*>& names)
+{
+    return TfTokenVector(names.begin(), names.end());
+}
+
+bool
+_IsNotPending(const TfToken&)
+{
+    return false;
+}
+
+// Ops must exist, reproduce value from base and be idempotent
+bool
+_RoundTrip(const TfTokenVector& base, const TfTokenVector& value, std::size_t* opCount = nullptr)
+{
+    const TfToken& field = SdfChildrenKeys->PrimChildren;
+    std::optional<std::vector<ChildrenOp>> ops = RenderStudioChildrenDiff::Compute(field, base, value);
+    if (!ops.has_value())
+    {
+        LOG_ERROR << "No ops for " << base.size() << " -> " << value.size() << " children";
+        return false;
+    }
+
+    if (opCount)
+    {
+        *opCount = ops->size();
+    }
+
+    TfTokenVector children = base;
+    RenderStudioChildrenDiff::Apply(children, field, *ops, &_IsNotPending);
+    if (children != value)
+    {
+        return false;
+    }
+
+    RenderStudioChildrenDiff::Apply(children, field, *ops, &_IsNotPending);
+    return children == value;
+}
+
+ChildrenOp
+_Insert(const char* name, const char* anchor)
+{
+    return ChildrenOp { SdfChildrenKeys->PrimChildren, ChildrenOp::Type::Insert, TfToken(name), TfToken(anchor) };
+}
+
+// Replica of children list which applies own edits at once and sees them sequenced by server later
+struct _Replica
+{
+    TfTokenVector children;
+    TfTokenVector pending;
+
+    void Edit(const ChildrenOp& op)
+    {
+        RenderStudioChildrenDiff::Apply(children, op.field, { op }, &_IsNotPending);
+        pending.push_back(op.name);
+    }
+
+    void Receive(const ChildrenOp& op)
+    {
+        auto own = std::find(pending.begin(), pending.end(), op.name);
+        if (own != pending.end())
+        {
+            // Acknowledge of own edit, it's already applied
+            pending.erase(own);
+            return;
+        }
+
+        RenderStudioChildrenDiff::Apply(
+            children,
+            op.field,
+            { op },
+            [this](const TfToken& name) { return std::find(pending.begin(), pending.end(), name) != pending.end(); });
+    }
+};
+
+} // namespace
+
+namespace RenderStudio::Tests
+{
+
+bool
+ChildrenDiffMerge(const std::vector<std::string>& args)
+{
+    (void)args;
+
+    bool result = true;
+    const TfToken& field = SdfChildrenKeys->PrimChildren;
+    const TfTokenVector base = _MakeList({ "a", "b", "c", "d", "e", "f", "g", "h", "i", "j" });
+
+    // Single edits anywhere in the list
+    std::size_t opCount = 0;
+    TEST_CHECK(_RoundTrip(base, _MakeList({ "x", "a", "b", "c", "d", "e", "f", "g", "h", "i", "j" })), result);
+    TEST_CHECK(_RoundTrip(base, _MakeList({ "a", "b", "c", "d", "x", "e", "f", "g", "h", "i", "j" })), result);
+    TEST_CHECK(_RoundTrip(base, _MakeList({ "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "x" })), result);
+    TEST_CHECK(_RoundTrip(base, _MakeList({ "a", "b", "c", "d", "f", "g", "h", "i", "j" })), result);
+    TEST_CHECK(_RoundTrip(base, _MakeList({ "a", "b", "c", "d", "e", "f", "g", "h", "i" })), result);
+
+    // Longest increasing subsequence stays, only elements out of it are moved
+    TEST_CHECK(_RoundTrip(base, _MakeList({ "b", "c", "d", "e", "f", "g", "h", "i", "j", "a" }), &opCount), result);
+    TEST_CHECK(opCount == 1, result);
+    TEST_CHECK(_RoundTrip(base, _MakeList({ "j", "a", "b", "c", "d", "e", "f", "g", "h", "i" }), &opCount), result);
+    TEST_CHECK(opCount == 1, result);
+    TEST_CHECK(_RoundTrip(base, _MakeList({ "a", "h", "c", "d", "e", "f", "g", "b", "i", "j" }), &opCount), result);
+    TEST_CHECK(opCount == 2, result);
+
+    TfTokenVector swapped = _MakeList({ "b", "a", "c", "d", "e", "f", "g", "h", "i", "j" });
+    std::optional<std::vector<ChildrenOp>> ops = RenderStudioChildrenDiff::Compute(field, base, swapped);
+    TEST_CHECK(ops.has_value() && ops->size() == 1 && ops->front().type == ChildrenOp::Type::Move, result);
+
+    // Mixed insert, remove and move
+    TEST_CHECK(_RoundTrip(base, _MakeList({ "a", "c", "x", "d", "e", "b", "f", "g", "h", "i", "j", "y" })), result);
+
+    // Full list is cheaper
+    TEST_CHECK(!RenderStudioChildrenDiff::Compute(field, {}, base).has_value(), result);
+    TfTokenVector reversed(base.rbegin(), base.rend());
+    TEST_CHECK(!RenderStudioChildrenDiff::Compute(field, base, reversed).has_value(), result);
+
+    // Duplicated names aren't a children list
+    TfTokenVector duplicated = _MakeList({ "a", "b", "b", "c" });
+    TEST_CHECK(!RenderStudioChildrenDiff::Compute(field, duplicated, _MakeList({ "a", "c" })).has_value(), result);
+
+    // Ops of other field and ops which don't change anything
+    TfTokenVector children = base;
+    ChildrenOp otherField { SdfChildrenKeys->PropertyChildren, ChildrenOp::Type::Insert, TfToken("x"), TfToken() };
+    TEST_CHECK(!RenderStudioChildrenDiff::Apply(children, field, { otherField }, &_IsNotPending), result);
+    TEST_CHECK(!RenderStudioChildrenDiff::Apply(children, field, { _Insert("a", "j") }, &_IsNotPending), result);
+    TEST_CHECK(children == base, result);
+
+    // Element whose anchor was removed concurrently goes to the end
+    TEST_CHECK(RenderStudioChildrenDiff::Apply(children, field, { _Insert("x", "removed") }, &_IsNotPending), result);
+    TEST_CHECK(children.back() == TfToken("x"), result);
+
+    // Concurrent inserts after the same anchor converge: later sequenced element goes closer to anchor
+    const TfTokenVector initial = _MakeList({ "a", "b" });
+    _Replica first { initial };
+    _Replica second { initial };
+    _Replica observer { initial };
+
+    const ChildrenOp insertX = _Insert("x", "a");
+    const ChildrenOp insertY = _Insert("y", "a");
+    first.Edit(insertX);
+    second.Edit(insertY);
+
+    // Server sequences x before y
+    for (const ChildrenOp& op : { insertX, insertY })
+    {
+        first.Receive(op);
+        second.Receive(op);
+        observer.Receive(op);
+    }
+
+    const TfTokenVector expected = _MakeList({ "a", "y", "x", "b" });
+    TEST_CHECK(first.children == expected, result);
+    TEST_CHECK(second.children == expected, result);
+    TEST_CHECK(observer.children == expected, result);
+
+    return result;
+}
+
+} // namespace RenderStudio::Tests
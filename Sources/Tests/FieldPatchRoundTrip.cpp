@@ -0,0 +1,169 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Tests.h"
+
+#pragma warning(push, 0)
+#include <pxr/base/vt/dictionary.h>
+#include <pxr/usd/sdf/listOp.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/schema.h>
+#pragma warning(pop)
+
+#include <Resolver/FieldPatch.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace
+{
+
+using ListOpEdit = RenderStudio::API::ListOpEdit;
+
+SdfPathVector
+_MakePaths(const std::vector<const char*>& paths)
+{
+    return SdfPathVector(paths.begin(), paths.end());
+}
+
+// Edits must exist and rebuild value from base one by one, the same way receiver applies them
+bool
+_RoundTripListOp(const VtValue& base, const VtValue& value)
+{
+    const TfToken& field = SdfFieldKeys->InheritPaths;
+    std::optional<std::vector<ListOpEdit>> edits = RenderStudioFieldPatch::ComputeListOp(field, base, value);
+    if (!edits.has_value())
+    {
+        LOG_ERROR << "No list op edits for " << base.GetTypeName();
+        return false;
+    }
+
+    VtValue current = base;
+    for (const ListOpEdit& edit : *edits)
+    {
+        VtValue patched;
+        if (!RenderStudioFieldPatch::ApplyListOp(current, edit, &patched))
+        {
+            return false;
+        }
+        current = patched;
+    }
+
+    return current == value;
+}
+
+bool
+_RoundTripDictionary(const VtDictionary& base, const VtDictionary& value)
+{
+    const TfToken& field = SdfFieldKeys->CustomData;
+    std::optional<std::vector<RenderStudio::API::DictionaryOp>> ops
+        = RenderStudioFieldPatch::ComputeDictionary(field, VtValue(base), VtValue(value));
+    if (!ops.has_value())
+    {
+        return false;
+    }
+
+    VtValue current(base);
+    for (const RenderStudio::API::DictionaryOp& op : *ops)
+    {
+        current = RenderStudioFieldPatch::ApplyDictionary(current, op);
+    }
+
+    return current == VtValue(value);
+}
+
+} // namespace
+
+namespace RenderStudio::Tests
+{
+
+bool
+FieldPatchRoundTrip(const std::vector<std::string>& args)
+{
+    (void)args;
+
+    bool result = true;
+    const SdfPathVector prepended = _MakePaths({ "/P0", "/P1", "/P2", "/P3", "/P4", "/P5" });
+    const SdfPathVector deleted = _MakePaths({ "/D0", "/D1", "/D2", "/D3" });
+    const VtValue base(SdfPathListOp::Create(prepended, {}, deleted));
+
+    // Prepended item goes to the front, existing tail is kept
+    SdfPathVector morePrepended = prepended;
+    morePrepended.insert(morePrepended.begin(), SdfPath("/X"));
+    TEST_CHECK(_RoundTripListOp(base, VtValue(SdfPathListOp::Create(morePrepended, {}, deleted))), result);
+
+    // Several prepended items keep their order
+    morePrepended.insert(morePrepended.begin(), SdfPath("/Y"));
+    TEST_CHECK(_RoundTripListOp(base, VtValue(SdfPathListOp::Create(morePrepended, {}, deleted))), result);
+
+    // Deleted items are added to the back and taken out of the middle
+    SdfPathVector moreDeleted = _MakePaths({ "/D0", "/D2", "/D3", "/X" });
+    TEST_CHECK(_RoundTripListOp(base, VtValue(SdfPathListOp::Create(prepended, {}, moreDeleted))), result);
+
+    // Item moved from prepended to deleted
+    SdfPathVector fewerPrepended = _MakePaths({ "/P0", "/P1", "/P2", "/P3", "/P4" });
+    moreDeleted = deleted;
+    moreDeleted.push_back(SdfPath("/P5"));
+    TEST_CHECK(_RoundTripListOp(base, VtValue(SdfPathListOp::Create(fewerPrepended, {}, moreDeleted))), result);
+
+    // Appended items and token list ops
+    const TfTokenVector tokens = { TfToken("a"), TfToken("b"), TfToken("c"), TfToken("d") };
+    TfTokenVector moreTokens = tokens;
+    moreTokens.push_back(TfToken("e"));
+    TEST_CHECK(
+        _RoundTripListOp(
+            VtValue(SdfTokenListOp::Create({}, tokens, {})), VtValue(SdfTokenListOp::Create({}, moreTokens, {}))),
+        result);
+
+    // Full value is cheaper
+    TEST_CHECK(!RenderStudioFieldPatch::ComputeListOp(
+                    SdfFieldKeys->InheritPaths, base, VtValue(SdfPathListOp::Create(deleted, {}, prepended)))
+                    .has_value(),
+               result);
+
+    // Explicit list ops are always sent whole
+    VtValue explicitValue(SdfPathListOp::CreateExplicit(prepended));
+    TEST_CHECK(!RenderStudioFieldPatch::ComputeListOp(SdfFieldKeys->InheritPaths, explicitValue, explicitValue)
+                    .has_value(),
+               result);
+
+    VtValue patched;
+    ListOpEdit edit { SdfFieldKeys->InheritPaths, ListOpEdit::Type::Prepend, VtValue(SdfPath("/X")) };
+    TEST_CHECK(!RenderStudioFieldPatch::ApplyListOp(explicitValue, edit, &patched), result);
+
+    // Item of other type than list op
+    ListOpEdit tokenEdit { SdfFieldKeys->InheritPaths, ListOpEdit::Type::Prepend, VtValue(TfToken("x")) };
+    TEST_CHECK(!RenderStudioFieldPatch::ApplyListOp(base, tokenEdit, &patched), result);
+
+    // Empty field is patched as empty list op
+    TEST_CHECK(RenderStudioFieldPatch::ApplyListOp(VtValue(), edit, &patched), result);
+    TEST_CHECK(patched == VtValue(SdfPathListOp::Create(_MakePaths({ "/X" }))), result);
+
+    // Dictionary keys are set, changed and erased one by one
+    VtDictionary dictionary;
+    for (int i = 0; i < 8; i++)
+    {
+        dictionary["key" + std::to_string(i)] = VtValue(i);
+    }
+
+    VtDictionary editedDictionary = dictionary;
+    editedDictionary["owner"] = VtValue(std::string("RenderStudioTests"));
+    editedDictionary["key0"] = VtValue(-1);
+    editedDictionary.erase("key1");
+    TEST_CHECK(_RoundTripDictionary(dictionary, editedDictionary), result);
+    TEST_CHECK(!_RoundTripDictionary(dictionary, VtDictionary()), result);
+
+    return result;
+}
+
+} // namespace RenderStudio::Tests
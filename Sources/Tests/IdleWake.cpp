@@ -0,0 +1,89 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LiveSession.h"
+#include "Tests.h"
+
+#pragma warning(push, 0)
+#include <chrono>
+#include <filesystem>
+
+#include <pxr/base/tf/hash.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/schema.h>
+#pragma warning(pop)
+
+#include <Utils/FileUtils.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace
+{
+
+SdfLayerRefPtr
+_CreatePrim()
+{
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous("IdleWake.usda");
+    SdfPrimSpecHandle prim = SdfPrimSpec::New(layer, "World", SdfSpecifierDef, "Xform");
+    SdfAttributeSpecHandle attribute = SdfAttributeSpec::New(prim, "size", SdfValueTypeNames->Float);
+    attribute->SetDefaultValue(VtValue(0.0f));
+    return layer;
+}
+
+// Same naming as RenderStudioJournal uses
+std::filesystem::path
+_GetJournalPath(const std::string& identifier)
+{
+    return RenderStudio::Utils::GetRenderStudioPath() / "Journal" / (std::to_string(TfHash {}(identifier)) + ".json");
+}
+
+} // namespace
+
+namespace RenderStudio::Tests
+{
+
+bool
+IdleWake(const std::vector<std::string>& args)
+{
+    (void)args;
+
+    PrepareWorkspace("IdleWake");
+    SdfLayerRefPtr layer = OpenLiveLayer(_CreatePrim(), "IdleWake.usda");
+
+    // Journal left by failed run would be restored into the layer
+    std::filesystem::path journal = _GetJournalPath(layer->GetIdentifier());
+    std::filesystem::remove(journal);
+
+    bool result = true;
+
+    // There's no connection, so edit is journaled once user stops editing
+    SdfPath path("/World.size");
+    layer->SetField(path, SdfFieldKeys->Default, VtValue(1.0f));
+    Kit::LiveSessionUpdate();
+    TEST_CHECK(!std::filesystem::exists(journal), result);
+
+    // Host doesn't poll, it only waits for the signal, which comes after idle delay without any events
+    TEST_CHECK(Kit::LiveSessionWaitForUpdate(std::chrono::seconds(10)), result);
+    Kit::LiveSessionUpdate();
+    TEST_CHECK(std::filesystem::exists(journal), result);
+
+    // Everything is journaled, host isn't woken up again
+    TEST_CHECK(!Kit::LiveSessionWaitForUpdate(std::chrono::seconds(1)), result);
+
+    std::filesystem::remove(journal);
+    return result;
+}
+
+} // namespace RenderStudio::Tests
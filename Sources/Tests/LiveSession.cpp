@@ -0,0 +1,113 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LiveSession.h"
+
+#pragma warning(push, 0)
+#include <fstream>
+#include <stdexcept>
+
+#include <pxr/usd/sdf/fileFormat.h>
+#pragma warning(pop)
+
+#include <Networking/WebsocketClient.h>
+
+namespace RenderStudio::Tests
+{
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+std::filesystem::path
+PrepareWorkspace(const std::string& name)
+{
+    std::filesystem::path workspace = std::filesystem::temp_directory_path() / "RenderStudioTests" / name;
+    std::filesystem::remove_all(workspace);
+    std::filesystem::create_directories(workspace);
+
+    Kit::SetWorkspacePath(workspace.string());
+    return workspace;
+}
+
+SdfLayerRefPtr
+OpenLiveLayer(const SdfLayerRefPtr& source, const std::string& name)
+{
+    // Resolver maps every layer to studio format, so file is written as plain text instead of exporting
+    std::string text;
+    if (!source->ExportToString(&text))
+    {
+        throw std::runtime_error("Can't export source layer of " + name);
+    }
+
+    std::ofstream file(std::filesystem::path(Kit::GetWorkspacePath()) / name);
+    file << text;
+    file.close();
+
+    SdfLayerRefPtr layer = SdfLayer::FindOrOpen("studio:/" + name);
+    if (layer == nullptr)
+    {
+        throw std::runtime_error("Can't open live layer " + name);
+    }
+
+    return layer;
+}
+
+SdfLayerRefPtr
+OpenLiveCrateLayer(const SdfLayerRefPtr& source, const std::string& name)
+{
+    // Written by crate format directly, export would go through studio format too
+    SdfFileFormatConstPtr crate = SdfFileFormat::FindById(TfToken("usdc"));
+    std::string path = (std::filesystem::path(Kit::GetWorkspacePath()) / name).string();
+    if (crate == nullptr || !crate->WriteToFile(*source, path))
+    {
+        throw std::runtime_error("Can't write crate file of " + name);
+    }
+
+    SdfLayerRefPtr layer = SdfLayer::FindOrOpen("studio:/" + name);
+    if (layer == nullptr)
+    {
+        throw std::runtime_error("Can't open live layer " + name);
+    }
+
+    return layer;
+}
+
+void
+DeliverMessage(const std::string& message)
+{
+    SdfFileFormatConstPtr format = SdfFileFormat::FindById(TfToken("studio"));
+    auto* client = dynamic_cast<Networking::IClientLogic*>(const_cast<SdfFileFormat*>(get_pointer(format)));
+
+    if (client == nullptr)
+    {
+        throw std::runtime_error("Studio file format isn't loaded");
+    }
+
+    client->OnMessage(message);
+}
+
+Kit::LiveSessionLayerStats
+GetLayerStats(const std::string& identifier)
+{
+    for (const Kit::LiveSessionLayerStats& stats : Kit::LiveSessionGetStats())
+    {
+        if (stats.identifier == identifier)
+        {
+            return stats;
+        }
+    }
+
+    return {};
+}
+
+} // namespace RenderStudio::Tests
@@ -0,0 +1,44 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <filesystem>
+#include <string>
+
+#include <pxr/usd/sdf/layer.h>
+#pragma warning(pop)
+
+#include <Kit.h>
+
+namespace RenderStudio::Tests
+{
+
+/// Empty workspace folder under temp directory, set as current workspace
+std::filesystem::path PrepareWorkspace(const std::string& name);
+
+/// Writes layer into workspace as usda and opens it as live layer
+pxr::SdfLayerRefPtr OpenLiveLayer(const pxr::SdfLayerRefPtr& source, const std::string& name);
+
+/// Writes layer into workspace as usdc and opens it as live layer, so it could be streamed from crate file
+pxr::SdfLayerRefPtr OpenLiveCrateLayer(const pxr::SdfLayerRefPtr& source, const std::string& name);
+
+/// Hands message over to live session as if it came from server
+void DeliverMessage(const std::string& message);
+
+/// Stats entry of single live layer, empty one if layer isn't registered
+Kit::LiveSessionLayerStats GetLayerStats(const std::string& identifier);
+
+} // namespace RenderStudio::Tests
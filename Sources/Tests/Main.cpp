@@ -0,0 +1,66 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma warning(push, 0)
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#pragma warning(pop)
+
+#include "Tests.h"
+
+#include <Logger/Logger.h>
+
+namespace
+{
+
+const std::map<std::string, RenderStudio::Tests::TestFn> kTests = {
+    { "SpecTableBenchmark", &RenderStudio::Tests::SpecTableBenchmark },
+    { "SubtreeReparent", &RenderStudio::Tests::SubtreeReparent },
+    { "ArenaSteadyState", &RenderStudio::Tests::ArenaSteadyState },
+    { "IdleWake", &RenderStudio::Tests::IdleWake },
+    { "StreamingSubtree", &RenderStudio::Tests::StreamingSubtree },
+    { "ArrayDiffRoundTrip", &RenderStudio::Tests::ArrayDiffRoundTrip },
+    { "ChildrenDiffMerge", &RenderStudio::Tests::ChildrenDiffMerge },
+    { "FieldPatchRoundTrip", &RenderStudio::Tests::FieldPatchRoundTrip },
+};
+
+} // namespace
+
+auto
+main(int argc, char** argv) -> int
+try
+{
+    if (argc < 2 || kTests.count(argv[1]) == 0)
+    {
+        std::cerr << "Usage: RenderStudioTests <case> [args...]" << std::endl << "Cases:" << std::endl;
+        for (const auto& [name, test] : kTests)
+        {
+            std::cerr << "    " << name << std::endl;
+        }
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> args(argv + 2, argv + argc);
+    bool passed = kTests.at(argv[1])(args);
+
+    LOG_INFO << argv[1] << (passed ? " passed" : " failed");
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+catch (const std::exception& ex)
+{
+    LOG_FATAL << "[Tests Fatal Exception] " << ex.what();
+    return EXIT_FAILURE;
+}
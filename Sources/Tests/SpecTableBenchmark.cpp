@@ -0,0 +1,198 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Tests.h"
+
+#pragma warning(push, 0)
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/fileFormat.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/schema.h>
+#pragma warning(pop)
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace
+{
+
+constexpr std::size_t kDefaultPrimCount = 100000;
+constexpr std::size_t kPrimsPerGroup = 100;
+constexpr std::size_t kAttributesPerPrim = 8;
+constexpr std::size_t kLookups = 1000000;
+
+struct _Timings
+{
+    double populate = 0.0;
+    double hasSpec = 0.0;
+    double getField = 0.0;
+    double hasField = 0.0;
+    double listFields = 0.0;
+
+    // Sum of lookup results, both layers must give the same
+    std::size_t checksum = 0;
+};
+
+template <typename Fn>
+double
+_MeasureMs(Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+_Timings
+_Run(const SdfLayerRefPtr& layer, std::size_t primCount, const std::vector<std::size_t>& order)
+{
+    _Timings timings;
+    std::vector<SdfPath> attributes;
+    attributes.reserve(primCount * kAttributesPerPrim);
+
+    // Prims are grouped, so appending to children list of a single huge scope doesn't dominate
+    timings.populate = _MeasureMs(
+        [&layer, &attributes, primCount]()
+        {
+            SdfChangeBlock block;
+            SdfPrimSpecHandle root = SdfPrimSpec::New(layer, "Root", SdfSpecifierDef, "Scope");
+            SdfPrimSpecHandle group;
+
+            for (std::size_t i = 0; i < primCount; i++)
+            {
+                if (i % kPrimsPerGroup == 0)
+                {
+                    group = SdfPrimSpec::New(root, TfStringPrintf("Group_%zu", i / kPrimsPerGroup), SdfSpecifierDef);
+                }
+
+                SdfPrimSpecHandle prim
+                    = SdfPrimSpec::New(group, TfStringPrintf("Prim_%zu", i), SdfSpecifierDef, "Xform");
+
+                for (std::size_t a = 0; a < kAttributesPerPrim; a++)
+                {
+                    SdfAttributeSpecHandle attribute
+                        = SdfAttributeSpec::New(prim, TfStringPrintf("attr_%zu", a), SdfValueTypeNames->Float);
+                    attribute->SetDefaultValue(VtValue(static_cast<float>(i + a)));
+                    attributes.push_back(attribute->GetPath());
+                }
+            }
+        });
+
+    std::size_t& checksum = timings.checksum;
+
+    timings.hasSpec = _MeasureMs(
+        [&]()
+        {
+            for (std::size_t i : order)
+            {
+                checksum += layer->HasSpec(attributes[i % attributes.size()]) ? 1 : 0;
+            }
+        });
+
+    timings.getField = _MeasureMs(
+        [&]()
+        {
+            for (std::size_t i : order)
+            {
+                VtValue value = layer->GetField(attributes[i % attributes.size()], SdfFieldKeys->Default);
+                checksum += value.IsHolding<float>() ? static_cast<std::size_t>(value.UncheckedGet<float>()) : 0;
+            }
+        });
+
+    timings.hasField = _MeasureMs(
+        [&]()
+        {
+            for (std::size_t i : order)
+            {
+                checksum += layer->HasField(attributes[i % attributes.size()], SdfFieldKeys->TypeName) ? 1 : 0;
+            }
+        });
+
+    timings.listFields = _MeasureMs(
+        [&]()
+        {
+            for (std::size_t i : order)
+            {
+                checksum += layer->ListFields(attributes[i % attributes.size()]).size();
+            }
+        });
+
+    return timings;
+}
+
+void
+_Print(const std::string& name, double reference, double studio)
+{
+    std::cout << std::left << std::setw(14) << name << std::right << std::setw(12) << reference << std::setw(12)
+              << studio << std::setw(10) << (studio > 0.0 ? reference / studio : 0.0) << "x" << std::endl;
+}
+
+} // namespace
+
+namespace RenderStudio::Tests
+{
+
+bool
+SpecTableBenchmark(const std::vector<std::string>& args)
+{
+    std::size_t primCount = args.empty() ? kDefaultPrimCount : std::stoul(args.front());
+
+    // Same lookup order for both layers
+    std::mt19937_64 random(42);
+    std::vector<std::size_t> order(kLookups);
+    for (std::size_t& i : order)
+    {
+        i = static_cast<std::size_t>(random());
+    }
+
+    // Anonymous usda layer is backed by SdfData, studio one by RenderStudioData
+    SdfLayerRefPtr reference = SdfLayer::CreateAnonymous("SpecTableBenchmark.usda");
+    SdfLayerRefPtr studio
+        = SdfLayer::CreateAnonymous("SpecTableBenchmark", SdfFileFormat::FindById(TfToken("studio")));
+
+    bool result = true;
+    TEST_CHECK(reference != nullptr && studio != nullptr, result);
+    if (!result)
+    {
+        return result;
+    }
+
+    _Timings referenceTimings = _Run(reference, primCount, order);
+    _Timings studioTimings = _Run(studio, primCount, order);
+
+    std::cout << primCount << " prims, " << primCount * kAttributesPerPrim << " attributes, " << kLookups
+              << " lookups per operation" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(14) << "ms" << std::right << std::setw(12) << "SdfData" << std::setw(12)
+              << "Studio" << std::setw(11) << "Speedup" << std::endl;
+
+    _Print("Populate", referenceTimings.populate, studioTimings.populate);
+    _Print("HasSpec", referenceTimings.hasSpec, studioTimings.hasSpec);
+    _Print("GetField", referenceTimings.getField, studioTimings.getField);
+    _Print("HasField", referenceTimings.hasField, studioTimings.hasField);
+    _Print("ListFields", referenceTimings.listFields, studioTimings.listFields);
+
+    TEST_CHECK(referenceTimings.checksum == studioTimings.checksum, result);
+    return result;
+}
+
+} // namespace RenderStudio::Tests
@@ -0,0 +1,148 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LiveSession.h"
+#include "Tests.h"
+
+#pragma warning(push, 0)
+#include <chrono>
+
+#include <pxr/base/tf/setenv.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/schema.h>
+#pragma warning(pop)
+
+#include <Serialization/Api.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace
+{
+
+SdfLayerRefPtr
+_CreateHierarchy()
+{
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous("StreamingSubtree.usda");
+
+    SdfPrimSpecHandle a = SdfPrimSpec::New(layer, "A", SdfSpecifierDef, "Xform");
+    SdfPrimSpecHandle b = SdfPrimSpec::New(a, "B", SdfSpecifierDef, "Xform");
+    SdfPrimSpecHandle c = SdfPrimSpec::New(b, "C", SdfSpecifierDef, "Xform");
+    SdfAttributeSpecHandle attribute = SdfAttributeSpec::New(c, "size", SdfValueTypeNames->Float);
+    attribute->SetDefaultValue(VtValue(1.0f));
+    SdfPrimSpec::New(layer, "Target", SdfSpecifierDef, "Xform");
+
+    return layer;
+}
+
+// Single namespace edit from other user, children lists of affected parents come along
+void
+_DeliverNamespaceEdit(
+    const SdfLayerRefPtr& layer,
+    std::size_t sequence,
+    const RenderStudio::API::NamespaceEdit& edit,
+    const std::vector<std::pair<SdfPath, TfTokenVector>>& children)
+{
+    RenderStudio::API::DeltaEvent delta;
+    delta.layer = layer->GetIdentifier();
+    delta.user = "RenderStudioTests";
+    delta.sequence = sequence;
+    delta.namespaceEdits.push_back(edit);
+
+    for (const auto& [path, names] : children)
+    {
+        RenderStudio::API::SpecData& spec = delta.updates[path];
+        spec.specType = path.IsAbsoluteRootPath() ? SdfSpecTypePseudoRoot : SdfSpecTypePrim;
+        spec.fields.emplace_back(SdfChildrenKeys->PrimChildren, VtValue(names));
+    }
+
+    RenderStudio::Tests::DeliverMessage(RenderStudio::API::SerializeDeltaEvent(delta));
+}
+
+// Every spec in layer, so orphans left in data are found too
+std::vector<SdfPath>
+_ListSpecs(const SdfLayerRefPtr& layer)
+{
+    std::vector<SdfPath> paths;
+    layer->Traverse(SdfPath::AbsoluteRootPath(), [&paths](const SdfPath& path) { paths.push_back(path); });
+    return paths;
+}
+
+} // namespace
+
+namespace RenderStudio::Tests
+{
+
+bool
+StreamingSubtree(const std::vector<std::string>& args)
+{
+    (void)args;
+
+    // Must be set before first layer is read
+    TfSetenv("RENDER_STUDIO_STREAMING_LAYERS", "1");
+
+    PrepareWorkspace("StreamingSubtree");
+    SdfLayerRefPtr layer = OpenLiveCrateLayer(_CreateHierarchy(), "StreamingSubtree.usdc");
+
+    bool result = true;
+    using Type = RenderStudio::API::NamespaceEdit::Type;
+
+    // Only deepest prim is materialized by other user's edit, its ancestors stay in crate file
+    SdfPath c("/A/B/C");
+    RenderStudio::API::DeltaEvent touch;
+    touch.layer = layer->GetIdentifier();
+    touch.user = "RenderStudioTests";
+    touch.sequence = 1;
+    touch.updates[c].specType = SdfSpecTypePrim;
+    touch.updates[c].fields.emplace_back(SdfFieldKeys->Documentation, VtValue(std::string("Touched")));
+    DeliverMessage(RenderStudio::API::SerializeDeltaEvent(touch));
+
+    TEST_CHECK(Kit::LiveSessionWaitForUpdate(std::chrono::seconds(10)), result);
+    Kit::LiveSessionUpdate();
+    TEST_CHECK(layer->GetField(c, SdfFieldKeys->Documentation) == VtValue(std::string("Touched")), result);
+
+    _DeliverNamespaceEdit(
+        layer,
+        2,
+        { Type::Move, SdfPath("/A"), SdfPath("/Target/A") },
+        { { SdfPath::AbsoluteRootPath(), { TfToken("Target") } }, { SdfPath("/Target"), { TfToken("A") } } });
+
+    TEST_CHECK(Kit::LiveSessionWaitForUpdate(std::chrono::seconds(10)), result);
+    Kit::LiveSessionUpdate();
+
+    SdfPath movedC("/Target/A/B/C");
+    TEST_CHECK(layer->HasSpec(movedC), result);
+    TEST_CHECK(layer->GetField(movedC, SdfFieldKeys->Documentation) == VtValue(std::string("Touched")), result);
+    TEST_CHECK(layer->GetField(movedC.AppendProperty(TfToken("size")), SdfFieldKeys->Default) == VtValue(1.0f), result);
+    TEST_CHECK(!layer->HasSpec(c), result);
+    TEST_CHECK(!layer->HasSpec(SdfPath("/A")), result);
+
+    _DeliverNamespaceEdit(
+        layer, 3, { Type::Erase, SdfPath("/Target/A"), SdfPath() }, { { SdfPath("/Target"), {} } });
+
+    TEST_CHECK(Kit::LiveSessionWaitForUpdate(std::chrono::seconds(10)), result);
+    Kit::LiveSessionUpdate();
+
+    TEST_CHECK(!layer->HasSpec(movedC), result);
+    TEST_CHECK(layer->HasSpec(SdfPath("/Target")), result);
+
+    for (const SdfPath& path : _ListSpecs(layer))
+    {
+        TEST_CHECK(!path.HasPrefix(SdfPath("/A")) && !path.HasPrefix(SdfPath("/Target/A")), result);
+    }
+
+    return result;
+}
+
+} // namespace RenderStudio::Tests
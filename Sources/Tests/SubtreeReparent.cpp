@@ -0,0 +1,119 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LiveSession.h"
+#include "Tests.h"
+
+#pragma warning(push, 0)
+#include <chrono>
+#include <iostream>
+
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/schema.h>
+#pragma warning(pop)
+
+#include <Serialization/Api.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace
+{
+
+constexpr std::size_t kDefaultPrimCount = 25000;
+constexpr std::size_t kPrimsPerGroup = 100;
+
+SdfLayerRefPtr
+_CreateAssembly(std::size_t primCount)
+{
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous("SubtreeReparent.usda");
+    SdfChangeBlock block;
+
+    SdfPrimSpecHandle world = SdfPrimSpec::New(layer, "World", SdfSpecifierDef, "Xform");
+    SdfPrimSpec::New(world, "Target", SdfSpecifierDef, "Xform");
+    SdfPrimSpecHandle assembly = SdfPrimSpec::New(world, "Assembly", SdfSpecifierDef, "Xform");
+    SdfPrimSpecHandle group;
+
+    for (std::size_t i = 0; i < primCount; i++)
+    {
+        if (i % kPrimsPerGroup == 0)
+        {
+            group = SdfPrimSpec::New(assembly, TfStringPrintf("Group_%zu", i / kPrimsPerGroup), SdfSpecifierDef);
+        }
+
+        SdfPrimSpecHandle prim = SdfPrimSpec::New(group, TfStringPrintf("Prim_%zu", i), SdfSpecifierDef, "Xform");
+        SdfAttributeSpecHandle attribute = SdfAttributeSpec::New(prim, "size", SdfValueTypeNames->Float);
+        attribute->SetDefaultValue(VtValue(static_cast<float>(i)));
+    }
+
+    return layer;
+}
+
+} // namespace
+
+namespace RenderStudio::Tests
+{
+
+bool
+SubtreeReparent(const std::vector<std::string>& args)
+{
+    std::size_t primCount = args.empty() ? kDefaultPrimCount : std::stoul(args.front());
+
+    PrepareWorkspace("SubtreeReparent");
+    SdfLayerRefPtr layer = OpenLiveLayer(_CreateAssembly(primCount), "SubtreeReparent.usda");
+
+    // Other user moves assembly under target, children lists of both parents come along in the same delta
+    RenderStudio::API::DeltaEvent delta;
+    delta.layer = layer->GetIdentifier();
+    delta.user = "RenderStudioTests";
+    delta.sequence = 1;
+    delta.namespaceEdits.push_back({ RenderStudio::API::NamespaceEdit::Type::Move,
+                                     SdfPath("/World/Assembly"),
+                                     SdfPath("/World/Target/Assembly") });
+
+    RenderStudio::API::SpecData& world = delta.updates[SdfPath("/World")];
+    world.specType = SdfSpecTypePrim;
+    world.fields.emplace_back(SdfChildrenKeys->PrimChildren, VtValue(TfTokenVector { TfToken("Target") }));
+
+    RenderStudio::API::SpecData& target = delta.updates[SdfPath("/World/Target")];
+    target.specType = SdfSpecTypePrim;
+    target.fields.emplace_back(SdfChildrenKeys->PrimChildren, VtValue(TfTokenVector { TfToken("Assembly") }));
+
+    DeliverMessage(RenderStudio::API::SerializeDeltaEvent(delta));
+
+    bool result = true;
+    TEST_CHECK(Kit::LiveSessionWaitForUpdate(std::chrono::seconds(10)), result);
+
+    auto start = std::chrono::steady_clock::now();
+    TEST_CHECK(Kit::LiveSessionUpdate(), result);
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Moved " << primCount * 2 + primCount / kPrimsPerGroup + 1 << " specs in " << elapsed << " ms"
+              << std::endl;
+
+    // Whole subtree is moved by single edit, values come along
+    SdfPath last(TfStringPrintf(
+        "/World/Target/Assembly/Group_%zu/Prim_%zu.size", (primCount - 1) / kPrimsPerGroup, primCount - 1));
+    TEST_CHECK(layer->HasSpec(last), result);
+    TEST_CHECK(layer->GetField(last, SdfFieldKeys->Default) == VtValue(static_cast<float>(primCount - 1)), result);
+    TEST_CHECK(!layer->HasSpec(SdfPath("/World/Assembly")), result);
+    TEST_CHECK(!layer->HasSpec(SdfPath("/World/Assembly/Group_0/Prim_0")), result);
+    TEST_CHECK(GetLayerStats(layer->GetIdentifier()).subtreeEdits == 1, result);
+
+    return result;
+}
+
+} // namespace RenderStudio::Tests
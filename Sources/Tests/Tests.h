@@ -0,0 +1,69 @@
+// Copyright 2023 Advanced Micro Devices, Inc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <string>
+#include <vector>
+#pragma warning(pop)
+
+#include <Logger/Logger.h>
+
+// Logs failed condition, test keeps running so all failures of single run are reported
+#define TEST_CHECK(_condition, _result)                   \
+    do                                                    \
+    {                                                     \
+        if (!(_condition))                                \
+        {                                                 \
+            LOG_ERROR << "Check failed: " << #_condition; \
+            _result = false;                              \
+        }                                                 \
+    } while (false)
+
+namespace RenderStudio::Tests
+{
+
+/// Test case, returns false on failure. Arguments are passed after case name on command line
+using TestFn = bool (*)(const std::vector<std::string>& args);
+
+/// Field lookups of studio layer compared to stock SdfData. Prints timings, fails only if layers differ.
+/// Optional argument is number of prims, each prim gets 8 attributes.
+bool SpecTableBenchmark(const std::vector<std::string>& args);
+
+/// Remote reparent of large assembly is applied as single subtree move.
+/// Optional argument is number of prims in assembly.
+bool SubtreeReparent(const std::vector<std::string>& args);
+
+/// Repeated remote updates of the same shape stop allocating from heap once frame arena is warmed up.
+/// Optional argument is number of prims written by each update.
+bool ArenaSteadyState(const std::vector<std::string>& args);
+
+/// Host which only waits for the update signal is woken up to journal local edits once they stop.
+bool IdleWake(const std::vector<std::string>& args);
+
+/// Remote move and erase of subtree, which is streamed from crate file and has only its deepest prim materialized.
+bool StreamingSubtree(const std::vector<std::string>& args);
+
+/// Sparse array diffs reproduce edited arrays, including edits at block edges and resizes.
+/// Malformed diffs are rejected.
+bool ArrayDiffRoundTrip(const std::vector<std::string>& args);
+
+/// Children list ops reproduce edited lists with minimal moves, and replicas inserting after the same anchor converge.
+bool ChildrenDiffMerge(const std::vector<std::string>& args);
+
+/// Dictionary and list op patches rebuild edited values, explicit list ops and mismatching items are refused.
+bool FieldPatchRoundTrip(const std::vector<std::string>& args);
+
+} // namespace RenderStudio::Tests